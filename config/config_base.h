@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2023-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -46,7 +46,7 @@
 
 /* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
 #ifndef CRYPTO_CONC_OPER_NUM
-#define CRYPTO_CONC_OPER_NUM                   8
+#define CRYPTO_CONC_OPER_NUM                   16
 #endif
 
 /* Enable PSA Crypto random number generator module */
@@ -99,6 +99,14 @@
 #define CRYPTO_IOVEC_BUFFER_SIZE               5120
 #endif
 
+/*
+ * Chunk size used to stream large inputs of multi-part hash, MAC, cipher and
+ * AEAD updates when MM-IOVEC is not enabled. 0 disables streaming.
+ */
+#ifndef CRYPTO_IOVEC_STREAM_CHUNK_SIZE
+#define CRYPTO_IOVEC_STREAM_CHUNK_SIZE         256
+#endif
+
 /* Use stored NV seed to provide entropy */
 #ifndef CRYPTO_NV_SEED
 #define CRYPTO_NV_SEED                         1
@@ -151,6 +159,16 @@
 #define ATTEST_INCLUDE_COSE_KEY_ID             0
 #endif
 
+/* The size of the buffer caching the encoded static claims of the token */
+#ifndef ATTEST_CLAIM_CACHE_SIZE
+#define ATTEST_CLAIM_CACHE_SIZE                0x200
+#endif
+
+/* The maximum number of functions in a PoX batch token, 0 to disable */
+#ifndef ATTEST_POX_BATCH_MAX_ENTRIES
+#define ATTEST_POX_BATCH_MAX_ENTRIES           8
+#endif
+
 /* The stack size of the Initial Attestation Secure Partition */
 #ifndef ATTEST_STACK_SIZE
 #define ATTEST_STACK_SIZE                      0x700
@@ -163,6 +181,28 @@
 #define ATTEST_TOKEN_PROFILE_PSA_IOT_1         1
 #endif
 
+/* PoX Partition Configs */
+
+/* Create the PoX report as a single token signed by the attestation service */
+#ifndef POX_SINGLE_TOKEN_REPORT
+#define POX_SINGLE_TOKEN_REPORT                0
+#endif
+
+/* The maximum number of executions of a function in a batched PoX request */
+#ifndef POX_BATCH_MAX_REPEAT
+#define POX_BATCH_MAX_REPEAT                   256
+#endif
+
+/* The level of the events recorded by the PoX trace, 0 to compile it out */
+#ifndef POX_TRACE_LEVEL
+#define POX_TRACE_LEVEL                        0
+#endif
+
+/* The number of events held by the PoX trace ring buffer */
+#ifndef POX_TRACE_BUF_ENTRIES
+#define POX_TRACE_BUF_ENTRIES                  32
+#endif
+
 /* ITS Partition Configs */
 
 /* Create flash FS if it doesn't exist for Internal Trusted Storage partition */
@@ -180,6 +220,21 @@
 #define ITS_VALIDATE_METADATA_FROM_FLASH       1
 #endif
 
+/* Keep a RAM index of the file metadata to avoid flash reads on file lookups */
+#ifndef ITS_FILE_INDEX
+#define ITS_FILE_INDEX                         0
+#endif
+
+/* Defer the compaction of data blocks after deletions until space is needed */
+#ifndef ITS_DEFERRED_COMPACTION
+#define ITS_DEFERRED_COMPACTION                0
+#endif
+
+/* Number of metadata updates journaled in a metadata block before a swap */
+#ifndef ITS_METADATA_JOURNAL_RECORDS
+#define ITS_METADATA_JOURNAL_RECORDS           0
+#endif
+
 /* The maximum asset size to be stored in the Internal Trusted Storage */
 #ifndef ITS_MAX_ASSET_SIZE
 #define ITS_MAX_ASSET_SIZE                     512
@@ -218,6 +273,11 @@
 #define TFM_ITS_ENC_NONCE_LENGTH               12
 #endif
 
+/* The size of the chunks ITS files are encrypted in, 0 to encrypt files as a whole */
+#ifndef TFM_ITS_ENC_CHUNK_SIZE
+#define TFM_ITS_ENC_CHUNK_SIZE                 0
+#endif
+
 /* PS Partition Configs */
 
 /* Create flash FS if it doesn't exist for Protected Storage partition */
@@ -250,6 +310,23 @@
 #define PS_NUM_ASSETS                          10
 #endif
 
+/* Authenticate the Protected Storage object table through a hash tree over
+ * chunks of entries, so that a table update only hashes the modified chunks
+ */
+#ifndef PS_OBJ_TABLE_MERKLE_AUTH
+#define PS_OBJ_TABLE_MERKLE_AUTH               0
+#endif
+
+/* The number of object table entries in each chunk of the hash tree */
+#ifndef PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES
+#define PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES        4
+#endif
+
+/* The maximum number of operations in a Protected Storage batch */
+#ifndef PS_MAX_BATCH_OPS
+#define PS_MAX_BATCH_OPS                       8
+#endif
+
 /* The stack size of the Protected Storage Secure Partition */
 #ifndef PS_STACK_SIZE
 #define PS_STACK_SIZE                          0x700
@@ -271,6 +348,11 @@
 #endif
 #endif
 
+/* The number of validated memory ranges cached per connection, 0 to disable */
+#ifndef CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES
+#define CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES  0
+#endif
+
 /* Disable the doorbell APIs */
 #ifndef CONFIG_TFM_DOORBELL_API
 #define CONFIG_TFM_DOORBELL_API                 0
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -53,7 +53,7 @@
 
 /* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
 #ifndef CRYPTO_CONC_OPER_NUM
-#define CRYPTO_CONC_OPER_NUM                   8
+#define CRYPTO_CONC_OPER_NUM                   16
 #endif
 
 /* Enable PSA Crypto random number generator module */
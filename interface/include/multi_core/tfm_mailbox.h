@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022-2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -88,8 +88,15 @@ struct mailbox_msg_t {
                                             * non-secure task when NSPE OS
                                             * enforces non-secure task isolation
                                             */
+    uint32_t                    batch_id;  /* ID shared by the messages of a
+                                            * batch, MAILBOX_NO_BATCH for a
+                                            * single PSA client call
+                                            */
 };
 
+/* Batch ID of a message which is not part of a batch */
+#define MAILBOX_NO_BATCH                    (0U)
+
 /*
  * Mailbox reply structure in non-secure memory
  * to hold the PSA client call return result from SPE
@@ -98,48 +105,61 @@ struct mailbox_reply_t {
     int32_t    return_val;
 };
 
+/*
+ * Version of the mailbox ABI shared by NSPE and SPE. It is increased whenever
+ * the layout of the shared structures below changes, so that SPE can reject
+ * an NSPE mailbox built against a different layout.
+ */
+#define MAILBOX_ABI_VERSION                 (3)
+
+/* Align a shared mailbox object to the start of a cache line */
+#define MAILBOX_CACHE_ALIGNED \
+                        __attribute__((aligned(MAILBOX_CACHE_LINE_SIZE)))
+
 /*
  * A single slot structure in NSPE mailbox queue.
  * This structure is an ABI between SPE and NSPE mailbox instances.
  * So, it must not include data that are not used by SPE like information about NS threads
  * or that depends on NSPE build settings.
- * TODO: It's good to align each slot structure according to the cache row,
- * so it will be easier to clean and invalidate slot during transfer between cores.
+ *
+ * Each slot is split into two cache-line-aligned parts, each written by a
+ * single core:
+ * - msg and req_seq are written by NSPE only. NSPE fills msg and then
+ *   increments req_seq to submit a PSA client call.
+ * - reply and reply_seq are written by SPE only. SPE fills reply and then sets
+ *   reply_seq to the req_seq value of the replied message.
+ * Neither core modifies data written by the other, so no cross-core lock is
+ * required and the slots can be cleaned and invalidated independently.
  */
 struct mailbox_slot_t {
     struct mailbox_msg_t   msg;
-    struct mailbox_reply_t reply;
-};
+    volatile uint32_t      req_seq;         /* Request doorbell */
 
-typedef uint32_t   mailbox_queue_status_t;
+    struct mailbox_reply_t reply MAILBOX_CACHE_ALIGNED;
+    volatile uint32_t      reply_seq;       /* Reply doorbell */
+} MAILBOX_CACHE_ALIGNED;
 
-/*
- * NSPE mailbox status shared between TF-M and mailbox client.
- * This structure is separated from slots to allow flexible allocation of slots.
- * So, it's safe to change number of slots on non-secure side without rebuild of TF-M.
- * TODO: It's good to align structure according to the cache row,
- * so it will be easier to clean and invalidate slot during transfer between cores.
- */
-struct mailbox_status_t {
-    mailbox_queue_status_t   pend_slots;        /* Bitmask of slots pending
-                                                 * for SPE handling
-                                                 */
-    mailbox_queue_status_t   replied_slots;     /* Bitmask of active slots
-                                                 * containing PSA client call
-                                                 * return result
-                                                 */
-};
+typedef uint32_t   mailbox_queue_status_t;
 
 /* Data used to send information to mailbox partition about mailbox queue allocated by non-secure image */
 struct mailbox_init_t {
-    /* Shared data with fixed size */
-    struct mailbox_status_t *status;
+    /* Mailbox ABI version of NSPE. Must be MAILBOX_ABI_VERSION. */
+    uint32_t version;
 
     /* Number of slots allocated by NS. */
     uint32_t slot_count;
 
     /* Pointer to struct mailbox_slot_t[slot_count] allocated by NS */
     struct mailbox_slot_t *slots;
+
+    /*
+     * Optional non-secure memory region allocated by NS to hold the payloads
+     * of PSA client calls. SPE validates the region once during
+     * initialization and skips the per-call memory checks of the vectors
+     * located inside it. shm_size is 0 if no region is provided.
+     */
+    void *shm_base;
+    uint32_t shm_size;
 };
 
 #ifdef __cplusplus
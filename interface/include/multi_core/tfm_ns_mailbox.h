@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -15,6 +15,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "cmsis_compiler.h"
 #include "tfm_mailbox.h"
 
 #ifdef __cplusplus
@@ -46,11 +47,17 @@ struct ns_mailbox_slot_t {
                                              * reply is received.
                                              */
 #endif
+    uint32_t    req_seq;                    /* Request doorbell value of the
+                                             * message awaiting the reply.
+                                             */
+    bool        is_pending;                 /* Indicate that a request has been
+                                             * submitted and its reply is not
+                                             * collected yet.
+                                             */
 };
 
 /* NSPE mailbox queue */
 struct ns_mailbox_queue_t {
-    struct mailbox_status_t status;
     struct mailbox_slot_t slots[NUM_MAILBOX_QUEUE_SLOT];
 
     /* Following data are not shared with secure */
@@ -58,6 +65,14 @@ struct ns_mailbox_queue_t {
 
     mailbox_queue_status_t   empty_slots;       /* Bitmask of empty slots */
 
+    void                     *shm_base;         /* Shared memory region for
+                                                 * payloads, passed to SPE
+                                                 * during initialization
+                                                 */
+    uint32_t                 shm_size;          /* Size of the shared memory
+                                                 * region, 0 if not used
+                                                 */
+
 #ifdef TFM_MULTI_CORE_TEST
     uint32_t                 nr_tx;             /* The total number of
                                                  * submission of NS PSA Client
@@ -74,6 +89,18 @@ struct ns_mailbox_queue_t {
     bool                     is_full;           /* Queue if full */
 };
 
+/* A PSA client call submitted in a batch */
+struct ns_mailbox_batch_call_t {
+    uint32_t                         call_type; /* PSA client call type */
+    const struct psa_client_params_t *params;   /* Parameters used for PSA
+                                                 * client call
+                                                 */
+    int32_t                          client_id; /* Optional client ID of the
+                                                 * non-secure caller.
+                                                 */
+    int32_t                          reply;     /* PSA client call result */
+};
+
 /**
  * \brief NSPE mailbox initialization
  *
@@ -85,6 +112,25 @@ struct ns_mailbox_queue_t {
  */
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue);
 
+/**
+ * \brief NSPE mailbox initialization with a shared memory region for payloads
+ *
+ * \param[in] queue             The base address of NSPE mailbox queue to be
+ *                              initialized.
+ * \param[in] shm_base          The base address of the non-secure memory
+ *                              region where clients place the payloads of
+ *                              PSA client calls.
+ * \param[in] shm_size          The size of the shared memory region.
+ *
+ * \retval MAILBOX_SUCCESS      Operation succeeded.
+ * \retval Other return code    Operation failed with an error code.
+ *
+ * \note SPE validates the region once. Vectors located in the region are then
+ *       passed to RoT Services without per-call memory checks.
+ */
+int32_t tfm_ns_mailbox_init_with_shm(struct ns_mailbox_queue_t *queue,
+                                     void *shm_base, uint32_t shm_size);
+
 /**
  * \brief Send PSA client call to SPE via mailbox. Wait and fetch PSA client
  *        call result.
@@ -104,6 +150,35 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
                                    int32_t client_id,
                                    int32_t *reply);
 
+/**
+ * \brief Send a batch of PSA client calls to SPE via mailbox with a single
+ *        notification. Wait and fetch the results of all the calls.
+ *
+ * \param[in,out] calls         The PSA client calls to be sent. The reply
+ *                              field of each call is written with its result.
+ * \param[in] num_calls         The number of PSA client calls in calls.
+ *                              It must not exceed NUM_MAILBOX_QUEUE_SLOT.
+ *
+ * \retval MAILBOX_SUCCESS      All the PSA client calls are completed.
+ * \retval MAILBOX_QUEUE_FULL   Not enough empty mailbox queue slots to hold
+ *                              the batch, or another batch is taking its
+ *                              units of the multi-core lock at the same
+ *                              time. None of the calls is sent.
+ * \retval Other return code    Operation failed with an error code.
+ *
+ * \note SPE mailbox replies to the calls of a batch with a single
+ *       notification after all of them are completed.
+ *
+ * \note Unlike \ref tfm_ns_mailbox_client_call, this function does not wait
+ *       for another batch being submitted concurrently. MAILBOX_QUEUE_FULL is
+ *       a transient condition and the caller can submit the batch again
+ *       later. It is never returned when
+ *       TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD is enabled, as the NS mailbox
+ *       thread waits for empty slots.
+ */
+int32_t tfm_ns_mailbox_client_call_batch(struct ns_mailbox_batch_call_t *calls,
+                                         uint8_t num_calls);
+
 #ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
 /**
  * \brief Handling PSA client calls in a dedicated NS mailbox thread.
@@ -346,20 +421,72 @@ static inline void clear_queue_slot_empty(struct ns_mailbox_queue_t *queue_ptr,
     }
 }
 
+/*
+ * Submit the message in a slot to SPE. The message must be filled before the
+ * request doorbell is rung.
+ */
 static inline void set_queue_slot_pend(struct ns_mailbox_queue_t *queue_ptr,
                                        uint8_t idx)
 {
+    uint32_t seq;
+
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        queue_ptr->status.pend_slots |= (1UL << idx);
+        /*
+         * Record the expected reply doorbell before ringing the request
+         * doorbell, so that the stale reply doorbell of the previous message
+         * is never taken as the reply.
+         */
+        seq = queue_ptr->slots[idx].req_seq + 1;
+        queue_ptr->slots_ns[idx].req_seq = seq;
+        queue_ptr->slots_ns[idx].is_pending = true;
+        __DMB();
+        queue_ptr->slots[idx].req_seq = seq;
     }
 }
 
+/*
+ * Check whether SPE has replied to the message submitted in a slot. The reply
+ * is only read after the reply doorbell matches the request doorbell.
+ */
+static inline bool is_queue_slot_replied(struct ns_mailbox_queue_t *queue_ptr,
+                                         uint8_t idx)
+{
+    if ((idx < NUM_MAILBOX_QUEUE_SLOT) &&
+        queue_ptr->slots_ns[idx].is_pending &&
+        (queue_ptr->slots[idx].reply_seq ==
+         queue_ptr->slots_ns[idx].req_seq)) {
+        __DMB();
+        return true;
+    }
+
+    return false;
+}
+
+static inline void clear_queue_slot_pend(struct ns_mailbox_queue_t *queue_ptr,
+                                         uint8_t idx)
+{
+    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
+        queue_ptr->slots_ns[idx].is_pending = false;
+    }
+}
+
+/*
+ * Collect the slots replied by SPE since the last call and mark them as no
+ * longer pending. Only the NSPE mailbox reply handler should call it.
+ */
 static inline mailbox_queue_status_t clear_queue_slot_all_replied(
                                            struct ns_mailbox_queue_t *queue_ptr)
 {
-    mailbox_queue_status_t status = queue_ptr->status.replied_slots;
+    mailbox_queue_status_t status = 0;
+    uint8_t idx;
+
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        if (is_queue_slot_replied(queue_ptr, idx)) {
+            clear_queue_slot_pend(queue_ptr, idx);
+            status |= (1UL << idx);
+        }
+    }
 
-    queue_ptr->status.replied_slots = 0;
     return status;
 }
 
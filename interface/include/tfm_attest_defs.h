@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -16,6 +16,8 @@ extern "C" {
 #define TFM_ATTEST_GET_TOKEN       1001
 #define TFM_ATTEST_GET_TOKEN_SIZE  1002
 #define TFM_ATTEST_GET_POX         1003
+#define TFM_ATTEST_GET_POX_RESULT  1004
+#define TFM_ATTEST_GET_POX_BATCH   1005
 
 #ifdef __cplusplus
 }
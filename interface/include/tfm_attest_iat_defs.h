@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -32,6 +32,7 @@ extern "C" {
 #define IAT_POX_IA                         (IAT_ARM_RANGE_BASE - 11)
 #define IAT_POX_FADDR                      (IAT_ARM_RANGE_BASE - 12)
 #define IAT_POX_OUT                        (IAT_ARM_RANGE_BASE - 13)
+#define IAT_POX_BATCH                      (IAT_ARM_RANGE_BASE - 14)
 
 /* Indicates that the boot status intentionally (i.e. the bootloader is not
  * capable of producing it) does not contain any SW components' measurement.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -12,6 +12,7 @@
 extern "C" {
 #endif
 
+#include "psa/client.h"
 #include "psa/crypto.h"
 #ifdef PLATFORM_DEFAULT_CRYPTO_KEYS
 #include "crypto_keys/tfm_builtin_key_ids.h"
@@ -36,6 +37,13 @@ struct tfm_crypto_aead_pack_input {
     uint32_t nonce_length;
 };
 
+/**
+ * \brief The maximum number of fragments passed to the service in a single
+ *        batched update call. The first IOVEC of the call is always used by
+ *        struct tfm_crypto_pack_iovec.
+ */
+#define TFM_CRYPTO_UPDATE_BATCH_MAX_FRAGMENTS (PSA_MAX_IOVEC - 1)
+
 /**
  * \brief Structure used to pack non-pointer types in a call to PSA Crypto APIs
  *
@@ -103,7 +111,8 @@ enum tfm_crypto_group_id_t {
     X(TFM_CRYPTO_HASH_CLONE)                       \
     X(TFM_CRYPTO_HASH_FINISH)                      \
     X(TFM_CRYPTO_HASH_VERIFY)                      \
-    X(TFM_CRYPTO_HASH_ABORT)
+    X(TFM_CRYPTO_HASH_ABORT)                       \
+    X(TFM_CRYPTO_HASH_UPDATE_BATCH)
 
 #define MAC_FUNCS                                  \
     X(TFM_CRYPTO_MAC_COMPUTE)                      \
@@ -113,7 +122,8 @@ enum tfm_crypto_group_id_t {
     X(TFM_CRYPTO_MAC_UPDATE)                       \
     X(TFM_CRYPTO_MAC_SIGN_FINISH)                  \
     X(TFM_CRYPTO_MAC_VERIFY_FINISH)                \
-    X(TFM_CRYPTO_MAC_ABORT)
+    X(TFM_CRYPTO_MAC_ABORT)                        \
+    X(TFM_CRYPTO_MAC_UPDATE_BATCH)
 
 #define CIPHER_FUNCS                               \
     X(TFM_CRYPTO_CIPHER_ENCRYPT)                   \
@@ -207,6 +217,42 @@ enum tfm_crypto_func_sid_t {
 #define TFM_CRYPTO_GET_GROUP_ID(_function_id) \
     ((enum tfm_crypto_group_id_t)(((uint16_t)(_function_id) >> 8) & 0xFF))
 
+/**
+ * \brief Adds a list of fragments to a multi-part hash operation, as if
+ *        \ref psa_hash_update was called on each fragment in order.
+ *
+ * \param[in,out] operation      Active hash operation
+ * \param[in]     fragments      Fragments of the message, each described by
+ *                               its base address and length
+ * \param[in]     num_fragments  Number of fragments
+ *
+ * \note Up to \ref TFM_CRYPTO_UPDATE_BATCH_MAX_FRAGMENTS fragments are passed
+ *       to the service in each call.
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_hash_update_batch(psa_hash_operation_t *operation,
+                                          const psa_invec *fragments,
+                                          size_t num_fragments);
+
+/**
+ * \brief Adds a list of fragments to a multi-part MAC operation, as if
+ *        \ref psa_mac_update was called on each fragment in order.
+ *
+ * \param[in,out] operation      Active MAC operation
+ * \param[in]     fragments      Fragments of the message, each described by
+ *                               its base address and length
+ * \param[in]     num_fragments  Number of fragments
+ *
+ * \note Up to \ref TFM_CRYPTO_UPDATE_BATCH_MAX_FRAGMENTS fragments are passed
+ *       to the service in each call.
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_mac_update_batch(psa_mac_operation_t *operation,
+                                         const psa_invec *fragments,
+                                         size_t num_fragments);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,11 @@
 #ifndef __TFM_ITS_DEFS_H__
 #define __TFM_ITS_DEFS_H__
 
+#include <stddef.h>
+
+#include "psa/error.h"
+#include "psa/storage_common.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,6 +25,44 @@ extern "C" {
 #define TFM_ITS_GET                1002
 #define TFM_ITS_GET_INFO           1003
 #define TFM_ITS_REMOVE             1004
+#define TFM_ITS_SET_EXTENDED       1005
+
+/**
+ * \brief Overwrites part of the data of an existing uid/value pair.
+ *
+ * Writes `data_length` bytes from `p_data` to the data associated with `uid`,
+ * starting at `data_offset` bytes from the beginning of the data. The range
+ * must lie within the current size of the data, so the size of the data does
+ * not change. The data is streamed to the storage without being buffered as
+ * a whole, and the update is atomic.
+ *
+ * \param[in] uid          The identifier for the data
+ * \param[in] data_offset  The offset within the data at which to write
+ * \param[in] data_length  The size in bytes of the data in `p_data`
+ * \param[in] p_data       A buffer containing the data
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                 The operation completed successfully
+ * \retval PSA_ERROR_DOES_NOT_EXIST    The operation failed because the
+ *                                     provided `uid` value was not found in
+ *                                     the storage
+ * \retval PSA_ERROR_NOT_PERMITTED     The operation failed because the provided
+ *                                     `uid` value was created with
+ *                                     PSA_STORAGE_FLAG_WRITE_ONCE
+ * \retval PSA_ERROR_NOT_SUPPORTED     The operation failed because the data is
+ *                                     stored encrypted as a whole and can only
+ *                                     be written as a whole
+ * \retval PSA_ERROR_INVALID_ARGUMENT  The operation failed because the range
+ *                                     to write is not within the current size
+ *                                     of the data
+ * \retval PSA_ERROR_STORAGE_FAILURE   The operation failed because the physical
+ *                                     storage has failed (Fatal error)
+ */
+psa_status_t tfm_its_set_extended(psa_storage_uid_t uid,
+                                  size_t data_offset,
+                                  size_t data_length,
+                                  const void *p_data);
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,12 @@
 #ifndef __TFM_PS_DEFS_H__
 #define __TFM_PS_DEFS_H__
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "psa/error.h"
+#include "psa/storage_common.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,6 +27,58 @@ extern "C" {
 #define TFM_PS_GET_INFO           1003
 #define TFM_PS_REMOVE             1004
 #define TFM_PS_GET_SUPPORT        1005
+#define TFM_PS_BATCH              1006
+
+/* Operation types of a PS batch */
+#define TFM_PS_BATCH_OP_SET       1
+#define TFM_PS_BATCH_OP_REMOVE    2
+
+/**
+ * \brief One operation of a PS batch.
+ */
+struct tfm_ps_batch_op_t {
+    psa_storage_uid_t uid;                   /*!< UID of the object */
+    uint32_t type;                           /*!< TFM_PS_BATCH_OP_SET or
+                                              *   TFM_PS_BATCH_OP_REMOVE
+                                              */
+    uint32_t data_length;                    /*!< Size of the object data for
+                                              *   TFM_PS_BATCH_OP_SET, 0
+                                              *   otherwise
+                                              */
+    psa_storage_create_flags_t create_flags; /*!< Flags for
+                                              *   TFM_PS_BATCH_OP_SET
+                                              */
+    uint32_t reserved;                       /*!< Must be 0 */
+};
+
+/**
+ * \brief Applies a batch of set and remove operations to the protected
+ *        storage atomically.
+ *
+ * \details The operations are applied in order, as if psa_ps_set() or
+ *          psa_ps_remove() had been called for each of them, and are committed
+ *          with a single object table update. Either all the operations take
+ *          effect or none of them.
+ *
+ * \param[in] ops          Array of operations
+ * \param[in] num_ops      Number of operations in \p ops
+ * \param[in] p_data       Data of all the TFM_PS_BATCH_OP_SET operations,
+ *                         concatenated in operation order
+ * \param[in] data_length  Size of \p p_data, which must be the sum of the
+ *                         data_length of all the operations
+ *
+ * \note Until the batch is committed, every set operation holds a new object
+ *       table entry in addition to the entry of the object it replaces, so a
+ *       batch can fail with PSA_ERROR_INSUFFICIENT_STORAGE when the table is
+ *       nearly full even if each operation would succeed on its own.
+ *
+ * \return A status indicating the success/failure of the operation. In
+ *         addition to the status codes of psa_ps_set() and psa_ps_remove(), it
+ *         returns PSA_ERROR_INVALID_ARGUMENT if the number of operations is 0
+ *         or bigger than the PS_MAX_BATCH_OPS of the service.
+ */
+psa_status_t tfm_ps_batch(const struct tfm_ps_batch_op_t *ops, size_t num_ops,
+                          const void *p_data, size_t data_length);
 
 #ifdef __cplusplus
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,13 +15,15 @@ extern "C" {
 #endif
 
 /*
- *  31           30-28   27    26-24  23-20   19     18-16   15-0
- * +------------+-----+------+-------+-----+-------+-------+------+
- * | NS vector  |     | NS   | invec |     | NS    | outvec| type |
- * | descriptor | Res | invec| number| Res | outvec| number|      |
- * +------------+-----+------+-------+-----+-------+-------+------+
+ *  31           30-29   28     27    26-24  23-20   19     18-16   15-0
+ * +------------+-----+-------+------+-------+-----+-------+-------+------+
+ * | NS vector  |     | Shm   | NS   | invec |     | NS    | outvec| type |
+ * | descriptor | Res | vector| invec| number| Res | outvec| number|      |
+ * +------------+-----+-------+------+-------+-----+-------+-------+------+
  *
  * Res: Reserved.
+ * Shm vector: All vectors are inside the NS shared memory region validated by
+ *             the mailbox NS agent. Only honoured for mailbox NS agents.
  */
 #define TYPE_MASK            0xFFFFUL
 
@@ -42,6 +44,8 @@ extern "C" {
 #define NS_INVEC_BIT         (1UL << NS_INVEC_OFFSET)
 #define NS_OUTVEC_OFFSET     19
 #define NS_OUTVEC_BIT        (1UL << NS_OUTVEC_OFFSET)
+#define SHM_VEC_OFFSET       28
+#define SHM_VEC_BIT          (1UL << SHM_VEC_OFFSET)
 
 #define PARAM_PACK(type, in_len, out_len)                            \
           ((((uint32_t)(type)) & TYPE_MASK)                        | \
@@ -64,6 +68,8 @@ extern "C" {
 #define PARAM_IS_NS_INVEC(ctrl_param)   ((ctrl_param) & NS_INVEC_BIT)
 #define PARAM_SET_NS_OUTVEC(ctrl_param) ((ctrl_param) | NS_OUTVEC_BIT)
 #define PARAM_IS_NS_OUTVEC(ctrl_param)  ((ctrl_param) & NS_OUTVEC_BIT)
+#define PARAM_SET_SHM_VEC(ctrl_param)   ((ctrl_param) | SHM_VEC_BIT)
+#define PARAM_IS_SHM_VEC(ctrl_param)    ((ctrl_param) & SHM_VEC_BIT)
 
 #define PARAM_HAS_IOVEC(ctrl_param)                                  \
           ((ctrl_param) != (uint32_t)PARAM_UNPACK_TYPE(ctrl_param))
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -17,6 +17,12 @@
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
+/* The ID of the last batch of PSA client calls */
+static uint32_t last_batch_id = MAILBOX_NO_BATCH;
+
+/* A batch of PSA client calls is taking its units of the multi-core lock */
+static bool batch_locking = false;
+
 static int32_t mailbox_wait_reply(uint8_t idx);
 
 static inline void set_queue_slot_empty(uint8_t idx)
@@ -49,24 +55,6 @@ static inline void clear_queue_slot_woken(uint8_t idx)
     }
 }
 
-#ifndef TFM_MULTI_CORE_NS_OS
-static inline void clear_queue_slot_replied(uint8_t idx)
-{
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        mailbox_queue_ptr->status.replied_slots &= ~(1UL << idx);
-    }
-}
-
-static inline bool is_queue_slot_replied(uint8_t idx)
-{
-    if (idx < NUM_MAILBOX_QUEUE_SLOT) {
-        return mailbox_queue_ptr->status.replied_slots & (1UL << idx);
-    }
-
-    return false;
-}
-#endif /* !defined TFM_MULTI_CORE_NS_OS */
-
 static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
 {
     uint8_t idx;
@@ -94,6 +82,22 @@ static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
     return idx;
 }
 
+/* Allocate an ID shared by all the messages of a batch */
+static uint32_t alloc_batch_id(void)
+{
+    uint32_t batch_id;
+
+    tfm_ns_mailbox_os_spin_lock();
+    last_batch_id++;
+    if (last_batch_id == MAILBOX_NO_BATCH) {
+        last_batch_id++;
+    }
+    batch_id = last_batch_id;
+    tfm_ns_mailbox_os_spin_unlock();
+
+    return batch_id;
+}
+
 static void set_msg_owner(uint8_t idx, const void *owner)
 {
     if (idx < NUM_MAILBOX_QUEUE_SLOT) {
@@ -101,20 +105,17 @@ static void set_msg_owner(uint8_t idx, const void *owner)
     }
 }
 
-static int32_t mailbox_tx_client_req(uint32_t call_type,
-                                     const struct psa_client_params_t *params,
-                                     int32_t client_id,
-                                     uint8_t *slot_idx)
+/*
+ * Fill the mailbox message in an acquired slot and ring its request doorbell.
+ * SPE is not notified.
+ */
+static void mailbox_tx_slot(uint8_t idx, uint32_t call_type,
+                            const struct psa_client_params_t *params,
+                            int32_t client_id, uint32_t batch_id)
 {
-    uint8_t idx;
     struct mailbox_msg_t *msg_ptr;
     const void *task_handle;
 
-    idx = acquire_empty_slot(mailbox_queue_ptr);
-    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
-        return MAILBOX_QUEUE_FULL;
-    }
-
 #ifdef TFM_MULTI_CORE_TEST
     tfm_ns_mailbox_tx_stats_update();
 #endif
@@ -125,6 +126,7 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     msg_ptr->call_type = call_type;
     memcpy(&msg_ptr->params, params, sizeof(msg_ptr->params));
     msg_ptr->client_id = client_id;
+    msg_ptr->batch_id = batch_id;
 
     /*
      * Fetch the current task handle. The task will be woken up according the
@@ -133,9 +135,26 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     task_handle = tfm_ns_mailbox_os_get_task_handle();
     set_msg_owner(idx, task_handle);
 
-    tfm_ns_mailbox_hal_enter_critical();
+    /*
+     * Ring the request doorbell of the slot. Only this task writes to the
+     * slot, so no lock shared with SPE is required.
+     */
     set_queue_slot_pend(mailbox_queue_ptr, idx);
-    tfm_ns_mailbox_hal_exit_critical();
+}
+
+static int32_t mailbox_tx_client_req(uint32_t call_type,
+                                     const struct psa_client_params_t *params,
+                                     int32_t client_id,
+                                     uint8_t *slot_idx)
+{
+    uint8_t idx;
+
+    idx = acquire_empty_slot(mailbox_queue_ptr);
+    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+        return MAILBOX_QUEUE_FULL;
+    }
+
+    mailbox_tx_slot(idx, call_type, params, client_id, MAILBOX_NO_BATCH);
 
     tfm_ns_mailbox_hal_notify_peer();
 
@@ -206,6 +225,104 @@ exit:
     return ret;
 }
 
+int32_t tfm_ns_mailbox_client_call_batch(struct ns_mailbox_batch_call_t *calls,
+                                         uint8_t num_calls)
+{
+    uint8_t slot_idx[NUM_MAILBOX_QUEUE_SLOT];
+    uint8_t i, nr_slots, nr_locks;
+    uint32_t batch_id;
+    int32_t ret = MAILBOX_SUCCESS;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    if (!calls || (num_calls == 0) || (num_calls > NUM_MAILBOX_QUEUE_SLOT)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    for (i = 0; i < num_calls; i++) {
+        if (!calls[i].params) {
+            return MAILBOX_INVAL_PARAMS;
+        }
+    }
+
+    /*
+     * Only one batch takes units of the multi-core lock at a time. Two batches
+     * each holding part of the units they need would wait for each other
+     * forever.
+     */
+    tfm_ns_mailbox_os_spin_lock();
+    if (batch_locking) {
+        tfm_ns_mailbox_os_spin_unlock();
+        return MAILBOX_QUEUE_FULL;
+    }
+    batch_locking = true;
+    tfm_ns_mailbox_os_spin_unlock();
+
+    /* The lock counts the slots, so take one unit per slot of the batch */
+    for (nr_locks = 0; nr_locks < num_calls; nr_locks++) {
+        if (tfm_ns_mailbox_os_lock_acquire() != MAILBOX_SUCCESS) {
+            break;
+        }
+    }
+
+    tfm_ns_mailbox_os_spin_lock();
+    batch_locking = false;
+    tfm_ns_mailbox_os_spin_unlock();
+
+    if (nr_locks < num_calls) {
+        ret = MAILBOX_QUEUE_FULL;
+        goto exit;
+    }
+
+    /* Acquire all the slots before submitting any call of the batch */
+    for (nr_slots = 0; nr_slots < num_calls; nr_slots++) {
+        slot_idx[nr_slots] = acquire_empty_slot(mailbox_queue_ptr);
+        if (slot_idx[nr_slots] >= NUM_MAILBOX_QUEUE_SLOT) {
+            break;
+        }
+    }
+
+    if (nr_slots < num_calls) {
+        tfm_ns_mailbox_os_spin_lock();
+        for (i = 0; i < nr_slots; i++) {
+            set_queue_slot_empty(slot_idx[i]);
+        }
+        tfm_ns_mailbox_os_spin_unlock();
+
+        ret = MAILBOX_QUEUE_FULL;
+        goto exit;
+    }
+
+    batch_id = alloc_batch_id();
+
+    /* It requires SVCall if NS mailbox is put in privileged mode. */
+    for (i = 0; i < num_calls; i++) {
+        mailbox_tx_slot(slot_idx[i], calls[i].call_type, calls[i].params,
+                        calls[i].client_id, batch_id);
+    }
+
+    /* A single notification for the whole batch */
+    tfm_ns_mailbox_hal_notify_peer();
+
+    for (i = 0; i < num_calls; i++) {
+        mailbox_wait_reply(slot_idx[i]);
+
+        /* It requires SVCall if NS mailbox is put in privileged mode. */
+        mailbox_rx_client_reply(slot_idx[i], &calls[i].reply);
+    }
+
+exit:
+    for (i = 0; i < nr_locks; i++) {
+        if (tfm_ns_mailbox_os_lock_release() != MAILBOX_SUCCESS) {
+            ret = MAILBOX_GENERIC_ERROR;
+        }
+    }
+
+    return ret;
+}
+
 #ifdef TFM_MULTI_CORE_NS_OS
 int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 {
@@ -216,9 +333,7 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
         return MAILBOX_INIT_ERROR;
     }
 
-    tfm_ns_mailbox_hal_enter_critical_isr();
     replied_status = clear_queue_slot_all_replied(mailbox_queue_ptr);
-    tfm_ns_mailbox_hal_exit_critical_isr();
 
     if (!replied_status) {
         return MAILBOX_NO_PEND_EVENT;
@@ -233,10 +348,8 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
             continue;
         }
 
-        /* Set woken-up flag */
-        tfm_ns_mailbox_hal_enter_critical_isr();
+        /* Set woken-up flag. A single store doesn't require a lock. */
         set_queue_slot_woken(idx);
-        tfm_ns_mailbox_hal_exit_critical_isr();
 
         tfm_ns_mailbox_os_wake_task_isr(
                                      mailbox_queue_ptr->slots_ns[idx].owner);
@@ -268,18 +381,12 @@ static inline bool mailbox_wait_reply_signal(uint8_t idx)
 #else /* TFM_MULTI_CORE_NS_OS */
 static inline bool mailbox_wait_reply_signal(uint8_t idx)
 {
-    bool is_set = false;
-
-    tfm_ns_mailbox_hal_enter_critical();
-
-    if (is_queue_slot_replied(idx)) {
-        clear_queue_slot_replied(idx);
-        is_set = true;
+    if (is_queue_slot_replied(mailbox_queue_ptr, idx)) {
+        clear_queue_slot_pend(mailbox_queue_ptr, idx);
+        return true;
     }
 
-    tfm_ns_mailbox_hal_exit_critical();
-
-    return is_set;
+    return false;
 }
 #endif /* TFM_MULTI_CORE_NS_OS */
 
@@ -288,11 +395,11 @@ static int32_t mailbox_wait_reply(uint8_t idx)
     bool is_replied;
 
     while (1) {
-        tfm_ns_mailbox_os_wait_reply();
-
         /*
-         * Woken up from sleep
-         * Check the completed flag to make sure that the current thread is
+         * Check the completed flag before sleeping. The replies to a batch can
+         * be signalled by a single wake-up, so the reply to a later slot may
+         * already be received.
+         * After being woken up, the flag makes sure that the current thread is
          * woken up by reply event, rather than other events.
          */
         /*
@@ -305,16 +412,24 @@ static int32_t mailbox_wait_reply(uint8_t idx)
         if (is_replied) {
             break;
         }
+
+        tfm_ns_mailbox_os_wait_reply();
     }
 
     return MAILBOX_SUCCESS;
 }
 
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
+{
+    return tfm_ns_mailbox_init_with_shm(queue, NULL, 0);
+}
+
+int32_t tfm_ns_mailbox_init_with_shm(struct ns_mailbox_queue_t *queue,
+                                     void *shm_base, uint32_t shm_size)
 {
     int32_t ret;
 
-    if (!queue) {
+    if (!queue || ((shm_base == NULL) && (shm_size != 0))) {
         return MAILBOX_INVAL_PARAMS;
     }
 
@@ -331,6 +446,9 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
     queue->empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
 
+    queue->shm_base = shm_base;
+    queue->shm_size = shm_size;
+
     mailbox_queue_ptr = queue;
 
     /* Platform specific initialization. */
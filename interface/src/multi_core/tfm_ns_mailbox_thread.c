@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -10,6 +10,9 @@
 #include <string.h>
 
 #include "tfm_ns_mailbox.h"
+#ifdef TFM_MULTI_CORE_TEST
+#include "tfm_ns_mailbox_test.h"
+#endif
 
 /* Thread woken up flag */
 #define NOT_WOKEN        0x0
@@ -41,6 +44,17 @@ struct ns_mailbox_req_t {
                                                    * up, after the reply is
                                                    * received.
                                                    */
+    struct ns_mailbox_batch_call_t   *calls;      /* Batch of PSA client calls.
+                                                   * NULL for a single PSA
+                                                   * client call.
+                                                   */
+    uint8_t                          num_calls;   /* Number of PSA client calls
+                                                   * in the batch.
+                                                   */
+    uint32_t                         batch_id;    /* Batch ID of the message,
+                                                   * MAILBOX_NO_BATCH for a
+                                                   * single PSA client call.
+                                                   */
 };
 
 /* Message queue handle */
@@ -52,6 +66,12 @@ static const void *ns_mailbox_thread_handle = NULL;
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
+/* Messages have been submitted but SPE is not notified yet */
+static bool notify_pending = false;
+
+/* The ID of the last batch of PSA client calls */
+static uint32_t last_batch_id = MAILBOX_NO_BATCH;
+
 static inline void set_queue_slot_all_empty(mailbox_queue_status_t completed)
 {
     mailbox_queue_ptr->empty_slots |= completed;
@@ -78,7 +98,15 @@ static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
             break;
         }
 
-        /* No empty slot */
+        /*
+         * No empty slot. Notify SPE of the messages submitted so far, which
+         * will release slots once they are replied.
+         */
+        if (notify_pending) {
+            notify_pending = false;
+            tfm_ns_mailbox_hal_notify_peer();
+        }
+
         queue->is_full = true;
         /* DSB to make sure the thread sleeps after the flag is set */
         __DSB();
@@ -102,10 +130,10 @@ static uint8_t acquire_empty_slot(struct ns_mailbox_queue_t *queue)
 }
 
 static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
-                                          uint8_t *slot_idx)
+                                          bool notify, uint8_t *slot_idx)
 {
     struct mailbox_msg_t *msg_ptr;
-    struct mailbox_reply_t *reply_ptr;
+    struct ns_mailbox_slot_t *slot_ns_ptr;
     uint8_t idx = NUM_MAILBOX_QUEUE_SLOT;
 
     idx = acquire_empty_slot(mailbox_queue_ptr);
@@ -118,27 +146,32 @@ static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
 #endif
 
     /* Fill the mailbox message */
-    msg_ptr = &mailbox_queue_ptr->queue[idx].msg;
+    msg_ptr = &mailbox_queue_ptr->slots[idx].msg;
     msg_ptr->call_type = req->call_type;
     memcpy(&msg_ptr->params, req->params_ptr, sizeof(msg_ptr->params));
     msg_ptr->client_id = req->client_id;
+    msg_ptr->batch_id = req->batch_id;
 
     /* Prepare the reply structure */
-    reply_ptr = &mailbox_queue_ptr->queue[idx].reply;
-    reply_ptr->owner = req->owner;
-    reply_ptr->reply = req->reply;
-    reply_ptr->woken_flag = req->woken_flag;
+    slot_ns_ptr = &mailbox_queue_ptr->slots_ns[idx];
+    slot_ns_ptr->owner = req->owner;
+    slot_ns_ptr->reply = req->reply;
+    slot_ns_ptr->woken_flag = req->woken_flag;
 
     /*
      * Memory check can be added here to prevent a malicious application
      * from providing addresses of other applications or privileged area.
      */
 
-    tfm_ns_mailbox_hal_enter_critical();
+    /* Ring the request doorbell. No lock shared with SPE is required. */
     set_queue_slot_pend(mailbox_queue_ptr, idx);
-    tfm_ns_mailbox_hal_exit_critical();
 
-    tfm_ns_mailbox_hal_notify_peer();
+    if (notify) {
+        notify_pending = false;
+        tfm_ns_mailbox_hal_notify_peer();
+    } else {
+        notify_pending = true;
+    }
 
     if (slot_idx) {
         *slot_idx = idx;
@@ -149,10 +182,10 @@ static int32_t mailbox_tx_client_call_msg(const struct ns_mailbox_req_t *req,
 
 static inline void ns_mailbox_set_reply_isr(uint8_t idx)
 {
-    int32_t *reply_ptr = mailbox_queue_ptr->queue[idx].reply.reply;
+    int32_t *reply_ptr = mailbox_queue_ptr->slots_ns[idx].reply;
 
     if (reply_ptr) {
-        *reply_ptr = mailbox_queue_ptr->queue[idx].reply.return_val;
+        *reply_ptr = mailbox_queue_ptr->slots[idx].reply.return_val;
     }
 }
 
@@ -197,6 +230,9 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
     req.woken_flag = &woken_flag;
     req.owner = tfm_ns_mailbox_os_get_task_handle();
     req.client_id = client_id;
+    req.calls = NULL;
+    req.num_calls = 0;
+    req.batch_id = MAILBOX_NO_BATCH;
 
     ret = tfm_ns_mailbox_os_mq_send(msgq_handle, &req);
     if (ret != MAILBOX_SUCCESS) {
@@ -208,6 +244,82 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
     return ret;
 }
 
+int32_t tfm_ns_mailbox_client_call_batch(struct ns_mailbox_batch_call_t *calls,
+                                         uint8_t num_calls)
+{
+    struct ns_mailbox_req_t req;
+    uint8_t woken_flags[NUM_MAILBOX_QUEUE_SLOT];
+    uint8_t i;
+    int32_t ret;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    if (!calls || (num_calls == 0) || (num_calls > NUM_MAILBOX_QUEUE_SLOT)) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    for (i = 0; i < num_calls; i++) {
+        if (!calls[i].params) {
+            return MAILBOX_INVAL_PARAMS;
+        }
+        woken_flags[i] = NOT_WOKEN;
+    }
+
+    /* The whole batch is passed to NS mailbox thread in a single request */
+    req.calls = calls;
+    req.num_calls = num_calls;
+    req.woken_flag = woken_flags;
+    req.owner = tfm_ns_mailbox_os_get_task_handle();
+    req.call_type = 0;
+    req.params_ptr = NULL;
+    req.client_id = 0;
+    req.reply = NULL;
+    req.batch_id = MAILBOX_NO_BATCH;
+
+    ret = tfm_ns_mailbox_os_mq_send(msgq_handle, &req);
+    if (ret != MAILBOX_SUCCESS) {
+        return ret;
+    }
+
+    for (i = 0; i < num_calls; i++) {
+        req.woken_flag = &woken_flags[i];
+        mailbox_wait_reply(&req);
+    }
+
+    return MAILBOX_SUCCESS;
+}
+
+/* Submit each call of a batch and notify SPE once after the last one */
+static void mailbox_tx_batch_msg(const struct ns_mailbox_req_t *batch_req)
+{
+    struct ns_mailbox_req_t req;
+    uint8_t i;
+
+    req.owner = batch_req->owner;
+    req.calls = NULL;
+    req.num_calls = 0;
+
+    /* Only NS mailbox thread submits messages, so no lock is required */
+    last_batch_id++;
+    if (last_batch_id == MAILBOX_NO_BATCH) {
+        last_batch_id++;
+    }
+    req.batch_id = last_batch_id;
+
+    for (i = 0; i < batch_req->num_calls; i++) {
+        req.call_type = batch_req->calls[i].call_type;
+        req.params_ptr = batch_req->calls[i].params;
+        req.client_id = batch_req->calls[i].client_id;
+        req.reply = &batch_req->calls[i].reply;
+        req.woken_flag = &batch_req->woken_flag[i];
+
+        mailbox_tx_client_call_msg(&req, (i == batch_req->num_calls - 1),
+                                   NULL);
+    }
+}
+
 void tfm_ns_mailbox_thread_runner(void *args)
 {
     struct ns_mailbox_req_t req;
@@ -223,6 +335,13 @@ void tfm_ns_mailbox_thread_runner(void *args)
             continue;
         }
 
+        if (req.calls) {
+            if (req.woken_flag && (req.num_calls > 0)) {
+                mailbox_tx_batch_msg(&req);
+            }
+            continue;
+        }
+
         /*
          * Invalid client address. However, the pointer was already
          * checked previously and therefore just simply ignore this
@@ -232,7 +351,7 @@ void tfm_ns_mailbox_thread_runner(void *args)
             continue;
         }
 
-        mailbox_tx_client_call_msg(&req, NULL);
+        mailbox_tx_client_call_msg(&req, true, NULL);
     }
 }
 
@@ -246,9 +365,7 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
         return MAILBOX_INIT_ERROR;
     }
 
-    tfm_ns_mailbox_hal_enter_critical_isr();
     replied_status = clear_queue_slot_all_replied(mailbox_queue_ptr);
-    tfm_ns_mailbox_hal_exit_critical_isr();
 
     if (!replied_status) {
         return MAILBOX_NO_PEND_EVENT;
@@ -276,7 +393,7 @@ int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
         /* Wake up the owner of this mailbox message */
         set_queue_slot_woken(idx);
 
-        task_handle = mailbox_queue_ptr->queue[idx].reply.owner;
+        task_handle = mailbox_queue_ptr->slots_ns[idx].owner;
         if (task_handle) {
             tfm_ns_mailbox_os_wake_task_isr(task_handle);
         }
@@ -316,10 +433,16 @@ static inline int32_t mailbox_req_queue_init(uint8_t queue_depth)
 }
 
 int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
+{
+    return tfm_ns_mailbox_init_with_shm(queue, NULL, 0);
+}
+
+int32_t tfm_ns_mailbox_init_with_shm(struct ns_mailbox_queue_t *queue,
+                                     void *shm_base, uint32_t shm_size)
 {
     int32_t ret;
 
-    if (!queue) {
+    if (!queue || ((shm_base == NULL) && (shm_size != 0))) {
         return MAILBOX_INVAL_PARAMS;
     }
 
@@ -336,6 +459,9 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
     queue->empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
 
+    queue->shm_base = shm_base;
+    queue->shm_size = shm_size;
+
     mailbox_queue_ptr = queue;
 
     /* Platform specific initialization. */
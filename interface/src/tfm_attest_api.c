@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -82,4 +82,66 @@ psa_proof_of_execution_get_token(uintptr_t *faddr,
     }
 
     return status;
-}
\ No newline at end of file
+}
+
+psa_status_t
+psa_proof_of_execution_get_result_token(uintptr_t      faddr,
+                                        int32_t        execution_value,
+                                        const uint8_t *auth_challenge,
+                                        size_t         challenge_size,
+                                        uint8_t       *token_buf,
+                                        size_t         token_buf_size,
+                                        size_t        *token_size)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        {&faddr, sizeof(faddr)},
+        {&execution_value, sizeof(execution_value)},
+        {auth_challenge, challenge_size}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+    status = psa_call(TFM_ATTESTATION_SERVICE_HANDLE, TFM_ATTEST_GET_POX_RESULT,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+
+    if (status == PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return status;
+}
+
+psa_status_t
+psa_proof_of_execution_get_batch_token(
+                                 const struct psa_pox_batch_entry_t *entries,
+                                 size_t         num_entries,
+                                 const uint8_t *auth_challenge,
+                                 size_t         challenge_size,
+                                 uint8_t       *token_buf,
+                                 size_t         token_buf_size,
+                                 size_t        *token_size)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        {entries, num_entries * sizeof(struct psa_pox_batch_entry_t)},
+        {auth_challenge, challenge_size}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+    status = psa_call(TFM_ATTESTATION_SERVICE_HANDLE, TFM_ATTEST_GET_POX_BATCH,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+
+    if (status == PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return status;
+}
@@ -56,6 +56,58 @@
 #define TFM_CRYPTO_API(ret, fun) ret fun
 #endif /* CONFIG_TFM_CRYPTO_API_RENAME */
 
+/**
+ * \brief Passes a list of fragments to a multi-part update function of the
+ *        service, grouping up to \ref TFM_CRYPTO_UPDATE_BATCH_MAX_FRAGMENTS
+ *        fragments in each call.
+ *
+ * \param[in] function_id    Batched update function ID
+ * \param[in] op_handle      Handle of the operation being updated
+ * \param[in] fragments      Fragments to be added to the operation
+ * \param[in] num_fragments  Number of fragments
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_update_batch(uint16_t function_id,
+                                            uint32_t op_handle,
+                                            const psa_invec *fragments,
+                                            size_t num_fragments)
+{
+    psa_status_t status = PSA_SUCCESS;
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = function_id,
+        .op_handle = op_handle,
+    };
+    psa_invec in_vec[PSA_MAX_IOVEC] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+    size_t num_vecs;
+
+    if ((fragments == NULL) && (num_fragments != 0)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    while (num_fragments > 0) {
+        num_vecs = num_fragments;
+        if (num_vecs > TFM_CRYPTO_UPDATE_BATCH_MAX_FRAGMENTS) {
+            num_vecs = TFM_CRYPTO_UPDATE_BATCH_MAX_FRAGMENTS;
+        }
+
+        (void)memcpy(&in_vec[1], fragments, num_vecs * sizeof(psa_invec));
+
+        status = psa_call(TFM_CRYPTO_HANDLE, PSA_IPC_CALL,
+                          in_vec, num_vecs + 1, (psa_outvec *)NULL, 0);
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+
+        fragments += num_vecs;
+        num_fragments -= num_vecs;
+    }
+
+    return status;
+}
+
 TFM_CRYPTO_API(psa_status_t, psa_crypto_init)(void)
 {
     /* Service init is performed during TFM boot up,
@@ -439,6 +491,15 @@ TFM_CRYPTO_API(psa_status_t, psa_hash_update)(psa_hash_operation_t *operation,
     return API_DISPATCH_NO_OUTVEC(in_vec);
 }
 
+psa_status_t tfm_crypto_hash_update_batch(psa_hash_operation_t *operation,
+                                          const psa_invec *fragments,
+                                          size_t num_fragments)
+{
+    return tfm_crypto_update_batch(TFM_CRYPTO_HASH_UPDATE_BATCH_SID,
+                                   operation->handle,
+                                   fragments, num_fragments);
+}
+
 TFM_CRYPTO_API(psa_status_t, psa_hash_finish)(psa_hash_operation_t *operation,
                                               uint8_t *hash,
                                               size_t hash_size,
@@ -635,6 +696,15 @@ TFM_CRYPTO_API(psa_status_t, psa_mac_update)(psa_mac_operation_t *operation,
     return API_DISPATCH_NO_OUTVEC(in_vec);
 }
 
+psa_status_t tfm_crypto_mac_update_batch(psa_mac_operation_t *operation,
+                                         const psa_invec *fragments,
+                                         size_t num_fragments)
+{
+    return tfm_crypto_update_batch(TFM_CRYPTO_MAC_UPDATE_BATCH_SID,
+                                   operation->handle,
+                                   fragments, num_fragments);
+}
+
 TFM_CRYPTO_API(psa_status_t, psa_mac_sign_finish)(psa_mac_operation_t *operation,
                                                   uint8_t *mac,
                                                   size_t mac_size,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -29,6 +29,25 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
     return status;
 }
 
+psa_status_t tfm_its_set_extended(psa_storage_uid_t uid,
+                                  size_t data_offset,
+                                  size_t data_length,
+                                  const void *p_data)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = &uid, .len = sizeof(uid) },
+        { .base = p_data, .len = data_length },
+        { .base = &data_offset, .len = sizeof(data_offset) }
+    };
+
+    status = psa_call(TFM_INTERNAL_TRUSTED_STORAGE_SERVICE_HANDLE,
+                      TFM_ITS_SET_EXTENDED, in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+    return status;
+}
+
 psa_status_t psa_its_get(psa_storage_uid_t uid,
                          size_t data_offset,
                          size_t data_size,
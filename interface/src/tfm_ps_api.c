@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -131,3 +131,19 @@ uint32_t psa_ps_get_support(void)
 
     return support_flags;
 }
+
+psa_status_t tfm_ps_batch(const struct tfm_ps_batch_op_t *ops, size_t num_ops,
+                          const void *p_data, size_t data_length)
+{
+    psa_status_t status;
+
+    psa_invec in_vec[] = {
+        { .base = ops,    .len = num_ops * sizeof(*ops) },
+        { .base = p_data, .len = data_length }
+    };
+
+    status = psa_call(TFM_PROTECTED_STORAGE_SERVICE_HANDLE, TFM_PS_BATCH,
+                      in_vec, IOVEC_LEN(in_vec), NULL, 0);
+
+    return status;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2019-2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -82,9 +82,11 @@ int32_t tfm_ns_mailbox_hal_init(struct ns_mailbox_queue_t *queue)
 
     /* Send out the address */
     struct mailbox_init_t ns_init;
-    ns_init.status = &queue->status;
+    ns_init.version = MAILBOX_ABI_VERSION;
     ns_init.slot_count = NUM_MAILBOX_QUEUE_SLOT;
     ns_init.slots = &queue->slots[0];
+    ns_init.shm_base = queue->shm_base;
+    ns_init.shm_size = queue->shm_size;
     platform_mailbox_send_msg_ptr(&ns_init);
 
     /* Wait until SPE mailbox service is ready */
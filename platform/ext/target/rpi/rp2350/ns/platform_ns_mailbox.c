@@ -75,9 +75,11 @@ int32_t tfm_ns_mailbox_hal_init(struct ns_mailbox_queue_t *queue)
 
     /* Send out the address */
     struct mailbox_init_t ns_init;
-    ns_init.status = &queue->status;
+    ns_init.version = MAILBOX_ABI_VERSION;
     ns_init.slot_count = NUM_MAILBOX_QUEUE_SLOT;
     ns_init.slots = &queue->slots[0];
+    ns_init.shm_base = queue->shm_base;
+    ns_init.shm_size = queue->shm_size;
     multicore_fifo_push_blocking((uint32_t) &ns_init);
 
     /* Wait until SPE mailbox service is ready */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -31,6 +31,8 @@ struct secure_mailbox_slot_t {
     struct mailbox_msg_t msg;
 
     uint8_t              ns_slot_idx;
+    uint32_t             req_seq;          /* Request doorbell value of msg */
+    uint32_t             batch_id;         /* Batch ID of msg */
     mailbox_msg_handle_t msg_handle;
 };
 
@@ -38,12 +40,15 @@ struct secure_mailbox_queue_t {
     mailbox_queue_status_t       empty_slots;      /* bitmask of empty slots */
 
     struct secure_mailbox_slot_t queue[NUM_MAILBOX_QUEUE_SLOT];
-    /* Shared data with fixed size */
-    struct mailbox_status_t       *ns_status;
+    /* Last request doorbell value consumed from each NS slot */
+    uint32_t                     ns_req_seq[NUM_MAILBOX_QUEUE_SLOT];
     /* Number of slots allocated by NS. */
     uint32_t                     ns_slot_count;
     /* Pointer to struct mailbox_slot_t[slot_count] allocated by NS */
     struct mailbox_slot_t        *ns_slots;
+    /* Optional NS shared memory region for payloads. Size 0 if not used. */
+    void                         *ns_shm_base;
+    uint32_t                     ns_shm_size;
 };
 
 /**
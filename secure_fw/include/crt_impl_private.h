@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,6 +13,22 @@
 
 #define ADDR_WORD_UNALIGNED(x)        ((x) & 0x3)
 
+/* Number of words copied or set by each iteration of the burst loops */
+#define WORDS_PER_BURST               4
+#define BYTES_PER_BURST               (WORDS_PER_BURST * sizeof(uint32_t))
+
+/*
+ * Merges two consecutive aligned words into the word which starts 'shift'
+ * bits into the lower addressed one. 'shift' must be 8, 16 or 24.
+ */
+#ifdef __ARM_BIG_ENDIAN
+#define WORD_MERGE(lo, hi, shift)     (((lo) << (shift)) | \
+                                       ((hi) >> (32U - (shift))))
+#else
+#define WORD_MERGE(lo, hi, shift)     (((lo) >> (shift)) | \
+                                       ((hi) << (32U - (shift))))
+#endif
+
 union composite_addr_t {
     uintptr_t uint_addr;        /* Address as integer value  */
     uint8_t   *p_byte;          /* Address in BYTE pointer   */
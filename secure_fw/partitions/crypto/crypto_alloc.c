@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -28,6 +28,20 @@ enum {
  */
 #define TFM_CRYPTO_INVALID_HANDLE (0x0u)
 
+/**
+ * \brief Layout of the handle of a multipart operation. The lower bits hold the
+ *        index of the context plus one, the upper bits hold the generation of
+ *        the context at allocation time, so that a stale handle of a released
+ *        operation is rejected once the context is allocated again.
+ */
+#define TFM_CRYPTO_HANDLE_IDX_MASK (0xFFu)
+#define TFM_CRYPTO_HANDLE_GEN_POS  (8u)
+#define TFM_CRYPTO_HANDLE_GEN_MASK (0xFFFFFFu)
+
+#if CRYPTO_CONC_OPER_NUM > 0xFF
+#error "CRYPTO_CONC_OPER_NUM exceeds the number of contexts a handle can encode"
+#endif
+
 /**
  * \brief A type describing the context stored in Secure memory by the TF-M Crypto
  *        service to support multipart calls on secure side
@@ -38,6 +52,10 @@ struct tfm_crypto_operation_s {
                                      *   the context
                                      */
     enum tfm_crypto_operation_type type; /*!< Type of the operation */
+    uint32_t generation;            /*!< Generation encoded in the handle */
+    uint32_t next_free;             /*!< Index of the next free context when
+                                     *   the context is not in use
+                                     */
     union {
         psa_cipher_operation_t cipher;    /*!< Cipher operation context */
         psa_mac_operation_t mac;          /*!< MAC operation context */
@@ -49,6 +67,9 @@ struct tfm_crypto_operation_s {
 
 static struct tfm_crypto_operation_s operations[CRYPTO_CONC_OPER_NUM] = {{0}};
 
+/* Index of the first free context, CRYPTO_CONC_OPER_NUM when none is free */
+static uint32_t free_head = CRYPTO_CONC_OPER_NUM;
+
 /*
  * \brief Function used to clear the memory associated to a backend context
  *
@@ -59,9 +80,56 @@ static struct tfm_crypto_operation_s operations[CRYPTO_CONC_OPER_NUM] = {{0}};
  */
 static void memset_operation_context(uint32_t index)
 {
+    size_t size;
+
+    /* Only the member of the given type has been used by the operation */
+    switch (operations[index].type) {
+    case TFM_CRYPTO_CIPHER_OPERATION:
+        size = sizeof(operations[index].operation.cipher);
+        break;
+    case TFM_CRYPTO_MAC_OPERATION:
+        size = sizeof(operations[index].operation.mac);
+        break;
+    case TFM_CRYPTO_HASH_OPERATION:
+        size = sizeof(operations[index].operation.hash);
+        break;
+    case TFM_CRYPTO_KEY_DERIVATION_OPERATION:
+        size = sizeof(operations[index].operation.key_deriv);
+        break;
+    case TFM_CRYPTO_AEAD_OPERATION:
+        size = sizeof(operations[index].operation.aead);
+        break;
+    default:
+        size = sizeof(operations[index].operation);
+        break;
+    }
+
     /* Clear the contents of the backend context */
-    (void)memset((uint8_t *)&(operations[index].operation), 0,
-                 sizeof(operations[index].operation));
+    (void)memset((uint8_t *)&(operations[index].operation), 0, size);
+}
+
+/*
+ * \brief Function used to get the context referenced by a handle
+ *
+ * \param[in] handle Handle of the operation
+ *
+ * \return Index of the context, or CRYPTO_CONC_OPER_NUM if the handle does not
+ *         reference a context in use
+ *
+ */
+static uint32_t handle_to_index(uint32_t handle)
+{
+    uint32_t index = (handle & TFM_CRYPTO_HANDLE_IDX_MASK) - 1;
+
+    if ((handle == TFM_CRYPTO_INVALID_HANDLE) ||
+        (index >= CRYPTO_CONC_OPER_NUM) ||
+        (operations[index].in_use != TFM_CRYPTO_IN_USE) ||
+        (operations[index].generation !=
+         (handle >> TFM_CRYPTO_HANDLE_GEN_POS))) {
+        return CRYPTO_CONC_OPER_NUM;
+    }
+
+    return index;
 }
 
 /*!
@@ -73,8 +141,17 @@ static void memset_operation_context(uint32_t index)
 /*!@{*/
 psa_status_t tfm_crypto_init_alloc(void)
 {
+    uint32_t i;
+
     /* Clear the contents of the local contexts */
     (void)memset(operations, 0, sizeof(operations));
+
+    /* Chain all the contexts in the free list */
+    for (i = 0; i < CRYPTO_CONC_OPER_NUM; i++) {
+        operations[i].next_free = i + 1;
+    }
+    free_head = 0;
+
     return PSA_SUCCESS;
 }
 
@@ -102,31 +179,39 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
         return status;
     }
 
-    for (i = 0; i < CRYPTO_CONC_OPER_NUM; i++) {
-        if (operations[i].in_use == TFM_CRYPTO_NOT_IN_USE) {
-            operations[i].in_use = TFM_CRYPTO_IN_USE;
-            operations[i].owner = partition_id;
-            operations[i].type = type;
-            *handle = i + 1;
-            *ctx = (void *) &(operations[i].operation);
-            return PSA_SUCCESS;
-        }
+    if (free_head >= CRYPTO_CONC_OPER_NUM) {
+        return PSA_ERROR_NOT_PERMITTED;
     }
 
-    return PSA_ERROR_NOT_PERMITTED;
+    i = free_head;
+    free_head = operations[i].next_free;
+
+    /* Generation 0 is skipped so that a handle is never reused right away */
+    operations[i].generation =
+                    (operations[i].generation + 1) & TFM_CRYPTO_HANDLE_GEN_MASK;
+    if (operations[i].generation == 0) {
+        operations[i].generation = 1;
+    }
+
+    operations[i].in_use = TFM_CRYPTO_IN_USE;
+    operations[i].owner = partition_id;
+    operations[i].type = type;
+    *handle = (operations[i].generation << TFM_CRYPTO_HANDLE_GEN_POS) | (i + 1);
+    *ctx = (void *) &(operations[i].operation);
+
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_crypto_operation_release(uint32_t *handle)
 {
-    uint32_t h_val = *handle;
+    uint32_t index = handle_to_index(*handle);
     int32_t partition_id = 0;
     psa_status_t status;
 
     /* Handle shall be cleaned up always at first */
     *handle = TFM_CRYPTO_INVALID_HANDLE;
 
-    if ((h_val == TFM_CRYPTO_INVALID_HANDLE) ||
-        (h_val > CRYPTO_CONC_OPER_NUM)) {
+    if (index >= CRYPTO_CONC_OPER_NUM) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
@@ -135,29 +220,31 @@ psa_status_t tfm_crypto_operation_release(uint32_t *handle)
         return status;
     }
 
-    if ((operations[h_val - 1].in_use == TFM_CRYPTO_IN_USE) &&
-        (operations[h_val - 1].owner == partition_id)) {
+    if (operations[index].owner != partition_id) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
 
-        memset_operation_context(h_val - 1);
-        operations[h_val - 1].in_use = TFM_CRYPTO_NOT_IN_USE;
-        operations[h_val - 1].type = TFM_CRYPTO_OPERATION_NONE;
-        operations[h_val - 1].owner = 0;
+    memset_operation_context(index);
+    operations[index].in_use = TFM_CRYPTO_NOT_IN_USE;
+    operations[index].type = TFM_CRYPTO_OPERATION_NONE;
+    operations[index].owner = 0;
 
-        return PSA_SUCCESS;
-    }
+    /* Put the context back to the head of the free list */
+    operations[index].next_free = free_head;
+    free_head = index;
 
-    return PSA_ERROR_INVALID_ARGUMENT;
+    return PSA_SUCCESS;
 }
 
 psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
                                          uint32_t handle,
                                          void **ctx)
 {
+    uint32_t index = handle_to_index(handle);
     int32_t partition_id = 0;
     psa_status_t status;
 
-    if ((handle == TFM_CRYPTO_INVALID_HANDLE) ||
-        (handle > CRYPTO_CONC_OPER_NUM)) {
+    if (index >= CRYPTO_CONC_OPER_NUM) {
         return PSA_ERROR_BAD_STATE;
     }
 
@@ -170,10 +257,9 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
         return status;
     }
 
-    if ((operations[handle - 1].in_use == TFM_CRYPTO_IN_USE) &&
-        (operations[handle - 1].type == type) &&
-        (operations[handle - 1].owner == partition_id)) {
-        *ctx = (void *) &(operations[handle - 1].operation);
+    if ((operations[index].type == type) &&
+        (operations[index].owner == partition_id)) {
+        *ctx = (void *) &(operations[index].operation);
         return PSA_SUCCESS;
     }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -123,6 +123,24 @@ psa_status_t tfm_crypto_hash_interface(psa_invec in_vec[],
 
         return psa_hash_update(operation, input, input_length);
     }
+    case TFM_CRYPTO_HASH_UPDATE_BATCH_SID:
+    {
+        size_t i;
+
+        /* Fragments are passed in the input vectors following the first */
+        for (i = 1; i < PSA_MAX_IOVEC; i++) {
+            if (in_vec[i].len == 0) {
+                continue;
+            }
+
+            status = psa_hash_update(operation, in_vec[i].base,
+                                     in_vec[i].len);
+            if (status != PSA_SUCCESS) {
+                break;
+            }
+        }
+        return status;
+    }
     case TFM_CRYPTO_HASH_FINISH_SID:
     {
         uint8_t *hash = out_vec[1].base;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -190,6 +190,114 @@ static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
 
     return PSA_SUCCESS;
 }
+
+#if CRYPTO_IOVEC_STREAM_CHUNK_SIZE > 0
+/**
+ * \brief Internal buffers used to stream the input of multi-part update
+ *        functions in chunks, instead of allocating it in the scratch
+ *
+ * \note The output buffer accounts for the data buffered in the operation by
+ *       cipher and AEAD updates.
+ */
+static struct tfm_crypto_stream {
+    __attribute__((__aligned__(TFM_CRYPTO_IOVEC_ALIGNMENT)))
+    uint8_t in_buf[CRYPTO_IOVEC_STREAM_CHUNK_SIZE];
+    __attribute__((__aligned__(TFM_CRYPTO_IOVEC_ALIGNMENT)))
+    uint8_t out_buf[CRYPTO_IOVEC_STREAM_CHUNK_SIZE +
+                    PSA_BLOCK_CIPHER_BLOCK_MAX_SIZE];
+} stream;
+
+/**
+ * \brief Checks whether a request is a multi-part update whose input is large
+ *        enough to be streamed in chunks
+ *
+ * \param[in] msg      Message received from the IPC framework
+ * \param[in] iov      Parameters read from the first input vector
+ * \param[in] in_len   Number of input vectors filled
+ * \param[in] out_len  Number of output vectors filled
+ *
+ * \return true if the input has to be streamed, false otherwise
+ */
+static bool tfm_crypto_is_stream_update(const psa_msg_t *msg,
+                                        const struct tfm_crypto_pack_iovec *iov,
+                                        size_t in_len, size_t out_len)
+{
+    size_t max_out_len;
+
+    switch (iov->function_id) {
+    case TFM_CRYPTO_HASH_UPDATE_SID:
+    case TFM_CRYPTO_MAC_UPDATE_SID:
+    case TFM_CRYPTO_AEAD_UPDATE_AD_SID:
+        max_out_len = 0;
+        break;
+    case TFM_CRYPTO_CIPHER_UPDATE_SID:
+    case TFM_CRYPTO_AEAD_UPDATE_SID:
+        max_out_len = 1;
+        break;
+    default:
+        return false;
+    }
+
+    return (in_len == 2) && (out_len <= max_out_len) &&
+           (msg->in_size[1] > CRYPTO_IOVEC_STREAM_CHUNK_SIZE);
+}
+
+/**
+ * \brief Processes a multi-part update by reading its input in chunks of
+ *        CRYPTO_IOVEC_STREAM_CHUNK_SIZE bytes and dispatching an update for
+ *        each chunk. The output produced by each chunk, if any, is written
+ *        back to the client straight away.
+ *
+ * \param[in]     msg      Message received from the IPC framework
+ * \param[in,out] in_vec   Input vectors, in_vec[0] already populated
+ * \param[in,out] out_vec  Output vectors
+ * \param[in]     out_len  Number of output vectors filled, 0 or 1
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+static psa_status_t tfm_crypto_stream_update(const psa_msg_t *msg,
+                                             psa_invec in_vec[],
+                                             psa_outvec out_vec[],
+                                             size_t out_len)
+{
+    psa_status_t status = PSA_SUCCESS;
+    size_t in_remaining = msg->in_size[1];
+    size_t out_remaining = (out_len > 0) ? msg->out_size[0] : 0;
+
+    while (in_remaining > 0) {
+        /* Read the next chunk of the input */
+        in_vec[1].base = stream.in_buf;
+        in_vec[1].len = psa_read(msg->handle, 1, stream.in_buf,
+                                 sizeof(stream.in_buf));
+        if ((in_vec[1].len == 0) || (in_vec[1].len > in_remaining)) {
+            status = PSA_ERROR_GENERIC_ERROR;
+            break;
+        }
+        in_remaining -= in_vec[1].len;
+
+        if (out_len > 0) {
+            out_vec[0].base = stream.out_buf;
+            out_vec[0].len = (out_remaining < sizeof(stream.out_buf)) ?
+                             out_remaining : sizeof(stream.out_buf);
+        }
+
+        status = tfm_crypto_api_dispatcher(in_vec, 2, out_vec, out_len);
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+
+        /* Write the output of the chunk after the output of previous ones */
+        if ((out_len > 0) && (out_vec[0].len > 0)) {
+            psa_write(msg->handle, 0, stream.out_buf, out_vec[0].len);
+            out_remaining -= out_vec[0].len;
+        }
+    }
+
+    (void)memset(&stream, 0, sizeof(stream));
+
+    return status;
+}
+#endif /* CRYPTO_IOVEC_STREAM_CHUNK_SIZE > 0 */
 #endif /* PSA_FRAMEWORK_HAS_MM_IOVEC == 1 */
 
 static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
@@ -223,6 +331,19 @@ static psa_status_t tfm_crypto_call_srv(const psa_msg_t *msg)
     in_vec[0].base = &iov;
     in_vec[0].len = sizeof(struct tfm_crypto_pack_iovec);
 
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) && (CRYPTO_IOVEC_STREAM_CHUNK_SIZE > 0)
+    /* Large inputs of multi-part updates don't go through the scratch */
+    if (tfm_crypto_is_stream_update(msg, &iov, in_len, out_len)) {
+        tfm_crypto_set_caller_id(msg->client_id);
+
+        status = tfm_crypto_stream_update(msg, in_vec, out_vec, out_len);
+
+        tfm_crypto_clear_scratch();
+
+        return status;
+    }
+#endif
+
     status = tfm_crypto_init_iovecs(msg, in_vec, in_len, out_vec, out_len);
     if (status != PSA_SUCCESS) {
         return status;
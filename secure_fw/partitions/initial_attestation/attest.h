@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -126,6 +126,47 @@ proof_of_execution(uintptr_t *faddr, const void *challenge_buf, size_t challenge
                    void *token_buf, size_t token_buf_size,
                    size_t *token_size);
 
+/*!
+ * \brief Get proof of execution token for a function which has already been
+ *        executed by the caller
+ *
+ * \param[in]     faddr           Address of the executed function
+ * \param[in]     execution_value Value returned by the executed function
+ * \param[in]     challenge_buf   Pointer to challenge buffer
+ * \param[in]     challenge_size  Size of challenge
+ * \param[out]    token_buf       Pointer to token buffer
+ * \param[in]     token_buf_size  Size of token buffer
+ * \param[out]    token_size      Pointer to store actual token size
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+proof_of_execution_result(uintptr_t faddr, int32_t execution_value,
+                          const void *challenge_buf, size_t challenge_size,
+                          void *token_buf, size_t token_buf_size,
+                          size_t *token_size);
+
+/*!
+ * \brief Get a single proof of execution token for a batch of functions
+ *        which have already been executed by the caller
+ *
+ * \param[in]     entries         Results of the executions of the batch
+ * \param[in]     num_entries     Number of entries
+ * \param[in]     challenge_buf   Pointer to challenge buffer
+ * \param[in]     challenge_size  Size of challenge
+ * \param[out]    token_buf       Pointer to token buffer
+ * \param[in]     token_buf_size  Size of token buffer
+ * \param[out]    token_size      Pointer to store actual token size
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+proof_of_execution_batch(const struct psa_pox_batch_entry_t *entries,
+                         size_t num_entries,
+                         const void *challenge_buf, size_t challenge_size,
+                         void *token_buf, size_t token_buf_size,
+                         size_t *token_size);
+
 #ifdef __cplusplus
 }
 #endif
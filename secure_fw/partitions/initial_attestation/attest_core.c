@@ -5,6 +5,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <stddef.h>
@@ -62,15 +63,6 @@ error_mapping_to_psa_status_t(enum psa_attest_err_t attest_err)
     }
 }
 
-psa_status_t attest_init(void)
-{
-    enum psa_attest_err_t res;
-
-    res = attest_boot_data_init();
-
-    return error_mapping_to_psa_status_t(res);
-}
-
 /*!
  * \brief Static function to map return values between \ref attest_token_err_t
  *        and \ref psa_attest_err_t
@@ -480,13 +472,13 @@ attest_add_nonce_claim(struct attest_token_encode_ctx *token_ctx,
  * \brief Static function to add the faddr to proof of execution.
  *
  * \param[in]  token_ctx  Token encoding context
- * \param[in]  faddr      Pointer to Function Address
+ * \param[in]  faddr      Function Address
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
 static enum psa_attest_err_t
 attest_add_faddr(struct attest_token_encode_ctx *token_ctx,
-                 const uintptr_t *faddr)
+                 uintptr_t faddr)
 {
     attest_token_encode_add_integer(token_ctx,
                                     IAT_POX_FADDR,
@@ -499,21 +491,62 @@ attest_add_faddr(struct attest_token_encode_ctx *token_ctx,
  * \brief Static function to add the execution value to proof of execution.
  *
  * \param[in]  token_ctx        Token encoding context
- * \param[in]  execution_value  Pointer to execution value
+ * \param[in]  execution_value  Execution value
  *
  * \return Returns error code as specified in \ref psa_attest_err_t
  */
 static enum psa_attest_err_t
 attest_add_execution_value(struct attest_token_encode_ctx *token_ctx,
-                 const int *execution_value)
+                           int32_t execution_value)
 {
     attest_token_encode_add_integer(token_ctx,
                                     IAT_POX_OUT,
-                                    (int64_t) execution_value);
+                                    (int64_t)execution_value);
 
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
+/*!
+ * \brief Static function to add the results of a batch of executions to
+ *        proof of execution.
+ *
+ * \param[in]  token_ctx    Token encoding context
+ * \param[in]  entries      Results of the executions of the batch
+ * \param[in]  num_entries  Number of entries
+ *
+ * \note Each entry is encoded as an array of the function address, the
+ *       execution value, the number of executions and the time they took.
+ *       The time is left out of entries without one.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_add_pox_batch(struct attest_token_encode_ctx *token_ctx,
+                     const struct psa_pox_batch_entry_t *entries,
+                     size_t num_entries)
+{
+    QCBOREncodeContext *cbor_encode_ctx;
+    size_t i;
+
+    cbor_encode_ctx = attest_token_encode_borrow_cbor_cntxt(token_ctx);
+
+    QCBOREncode_OpenArrayInMapN(cbor_encode_ctx, IAT_POX_BATCH);
+    for (i = 0; i < num_entries; ++i)
+    {
+        QCBOREncode_OpenArray(cbor_encode_ctx);
+        QCBOREncode_AddUInt64(cbor_encode_ctx, (uint64_t)entries[i].faddr);
+        QCBOREncode_AddInt64(cbor_encode_ctx, (int64_t)entries[i].output);
+        QCBOREncode_AddUInt64(cbor_encode_ctx, (uint64_t)entries[i].repeat);
+        if (entries[i].time != PSA_POX_TIME_NONE)
+        {
+            QCBOREncode_AddUInt64(cbor_encode_ctx, (uint64_t)entries[i].time);
+        }
+        QCBOREncode_CloseArray(cbor_encode_ctx);
+    }
+    QCBOREncode_CloseArray(cbor_encode_ctx);
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
 
 /*!
  * \brief Static function to verify the input challenge size
@@ -603,36 +636,254 @@ static enum psa_attest_err_t attest_get_t_cose_algorithm(
     return PSA_ATTEST_ERR_SUCCESS;
 }
 
+/*!
+ * \struct attest_claim_t
+ *
+ * \brief Claim of the token and how its value can be obtained
+ */
+struct attest_claim_t {
+    /* Function adding the claim to the token */
+    enum psa_attest_err_t (*add_claim)(struct attest_token_encode_ctx *);
+    /* The value of the claim does not change after boot */
+    bool is_static;
+};
+
 #if ATTEST_TOKEN_PROFILE_PSA_IOT_1 || ATTEST_TOKEN_PROFILE_PSA_2_0_0
-static enum psa_attest_err_t (*claim_query_funcs[])(struct attest_token_encode_ctx *) = {
-    &attest_add_boot_seed_claim,
-    &attest_add_instance_id_claim,
-    &attest_add_implementation_id_claim,
-    &attest_add_caller_id_claim,
-    &attest_add_security_lifecycle_claim,
-    &attest_add_all_sw_components,
-    &attest_add_profile_definition,
+static const struct attest_claim_t claim_query_funcs[] = {
+    {&attest_add_boot_seed_claim,          true},
+    {&attest_add_instance_id_claim,        true},
+    {&attest_add_implementation_id_claim,  true},
+    {&attest_add_caller_id_claim,          false},
+    {&attest_add_security_lifecycle_claim, false},
+    {&attest_add_all_sw_components,        true},
+    {&attest_add_profile_definition,       true},
 #if ATTEST_INCLUDE_OPTIONAL_CLAIMS
-    &attest_add_verification_service,
-    &attest_add_cert_ref_claim
+    {&attest_add_verification_service,     true},
+    {&attest_add_cert_ref_claim,           true},
 #endif
 };
 #elif ATTEST_TOKEN_PROFILE_ARM_CCA
 
-static enum psa_attest_err_t (*claim_query_funcs[])(struct attest_token_encode_ctx *) = {
-    &attest_add_instance_id_claim,
-    &attest_add_implementation_id_claim,
-    &attest_add_security_lifecycle_claim,
-    &attest_add_all_sw_components,
-    &attest_add_profile_definition,
-    &attest_add_hash_algo_claim,
-    &attest_add_platform_config_claim,
+static const struct attest_claim_t claim_query_funcs[] = {
+    {&attest_add_instance_id_claim,        true},
+    {&attest_add_implementation_id_claim,  true},
+    {&attest_add_security_lifecycle_claim, false},
+    {&attest_add_all_sw_components,        true},
+    {&attest_add_profile_definition,       true},
+    {&attest_add_hash_algo_claim,          true},
+    {&attest_add_platform_config_claim,    true},
 #if ATTEST_INCLUDE_OPTIONAL_CLAIMS
-    &attest_add_verification_service,
+    {&attest_add_verification_service,     true},
 #endif
 };
 #endif
 
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+/*!
+ * \struct attest_cached_claim_t
+ *
+ * \brief Label and CBOR encoded value of a static claim, encoded at init
+ */
+struct attest_cached_claim_t {
+    int32_t label;
+    /* Points to the claim cache buffer, NULL if the claim is not cached */
+    struct q_useful_buf_c value;
+};
+
+static uint8_t claim_cache_buf[ATTEST_CLAIM_CACHE_SIZE];
+static struct attest_cached_claim_t claim_cache[ARRAY_LENGTH(claim_query_funcs)];
+
+/*!
+ * \brief Static function to strip the integer label at the beginning of an
+ *        encoded map entry.
+ *
+ * \param[in,out] entry  Encoded label and value. Updated to the value only
+ * \param[out]    label  Decoded label
+ *
+ * \return Returns true if an integer label which fits in 32 bits was found
+ */
+static bool attest_strip_claim_label(struct q_useful_buf_c *entry,
+                                     int32_t *label)
+{
+    const uint8_t *head = entry->ptr;
+    uint8_t major_type;
+    uint8_t additional_info;
+    size_t head_len;
+    uint64_t argument;
+    size_t i;
+
+    if (entry->len == 0)
+    {
+        return false;
+    }
+
+    major_type = head[0] >> 5;
+    additional_info = head[0] & 0x1F;
+
+    /* Only unsigned and negative integer labels are used by the claims */
+    if (major_type > 1)
+    {
+        return false;
+    }
+
+    if (additional_info < 24)
+    {
+        head_len = 1;
+        argument = additional_info;
+    }
+    else if (additional_info <= 26)
+    {
+        /* 1, 2 or 4 bytes of argument follow */
+        head_len = 1 + (1U << (additional_info - 24));
+        if (entry->len < head_len)
+        {
+            return false;
+        }
+        argument = 0;
+        for (i = 1; i < head_len; i++)
+        {
+            argument = (argument << 8) | head[i];
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    if (argument > INT32_MAX)
+    {
+        return false;
+    }
+
+    *label = (major_type == 0) ? (int32_t)argument : -1 - (int32_t)argument;
+    entry->ptr = head + head_len;
+    entry->len -= head_len;
+
+    return true;
+}
+
+/*!
+ * \brief Static function to encode the static claims once and store their
+ *        encoded value in the claim cache.
+ *
+ * \note A claim which can not be encoded at this point, or which does not fit
+ *       in the remaining space of the cache, is not cached. It is then queried
+ *       and encoded for each token as usual.
+ */
+static void attest_cache_static_claims(void)
+{
+    struct attest_token_encode_ctx cache_ctx;
+    QCBOREncodeContext *cbor_encode_ctx;
+    struct q_useful_buf free_buf = {claim_cache_buf, sizeof(claim_cache_buf)};
+    struct q_useful_buf_c encoded;
+    const uint8_t *entry;
+    size_t used;
+    enum psa_attest_err_t err;
+    int i;
+
+    cbor_encode_ctx = attest_token_encode_borrow_cbor_cntxt(&cache_ctx);
+
+    for (i = 0; i < ARRAY_LENGTH(claim_query_funcs); ++i)
+    {
+        claim_cache[i].value = NULL_Q_USEFUL_BUF_C;
+
+        if (!claim_query_funcs[i].is_static)
+        {
+            continue;
+        }
+
+        /* Encode the claim alone in a map, to recover its label and value */
+        QCBOREncode_Init(cbor_encode_ctx, free_buf);
+        QCBOREncode_OpenMap(cbor_encode_ctx);
+        err = claim_query_funcs[i].add_claim(&cache_ctx);
+        QCBOREncode_CloseMap(cbor_encode_ctx);
+        if ((QCBOREncode_Finish(cbor_encode_ctx, &encoded) != QCBOR_SUCCESS) ||
+            (err != PSA_ATTEST_ERR_SUCCESS))
+        {
+            continue;
+        }
+
+        /* Exactly one entry is expected in the map */
+        entry = encoded.ptr;
+        if (entry[0] != 0xA1)
+        {
+            continue;
+        }
+        encoded.ptr = entry + 1;
+        encoded.len -= 1;
+
+        if (!attest_strip_claim_label(&encoded, &claim_cache[i].label))
+        {
+            continue;
+        }
+
+        claim_cache[i].value = encoded;
+
+        /* Keep the encoded claim, the next one is encoded after it */
+        used = ((const uint8_t *)encoded.ptr - entry) + encoded.len;
+        free_buf.ptr = (uint8_t *)free_buf.ptr + used;
+        free_buf.len -= used;
+    }
+}
+#endif /* ATTEST_CLAIM_CACHE_SIZE > 0 */
+
+psa_status_t attest_init(void)
+{
+    enum psa_attest_err_t res;
+
+    res = attest_boot_data_init();
+    if (res != PSA_ATTEST_ERR_SUCCESS)
+    {
+        return error_mapping_to_psa_status_t(res);
+    }
+
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+    attest_cache_static_claims();
+#endif
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to add all the claims, apart from the nonce, to the
+ *        attestation token.
+ *
+ * \param[in]  token_ctx  Token encoding context
+ *
+ * \note The already encoded value is spliced into the token for the static
+ *       claims found in the claim cache.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_add_all_claims(struct attest_token_encode_ctx *token_ctx)
+{
+    enum psa_attest_err_t attest_err;
+    int i;
+
+    for (i = 0; i < ARRAY_LENGTH(claim_query_funcs); ++i)
+    {
+#if ATTEST_CLAIM_CACHE_SIZE > 0
+        if (claim_cache[i].value.ptr != NULL)
+        {
+            attest_token_encode_add_cbor(token_ctx,
+                                         claim_cache[i].label,
+                                         &claim_cache[i].value);
+            continue;
+        }
+#endif
+
+        /* Calling the attest_add_XXX_claim functions */
+        attest_err = claim_query_funcs[i].add_claim(token_ctx);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+        {
+            return attest_err;
+        }
+    }
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
 /*!
  * \brief Static function to create the initial attestation token
  *
@@ -654,7 +905,6 @@ attest_create_token(struct q_useful_buf_c *challenge,
     enum attest_token_err_t token_err;
     struct attest_token_encode_ctx attest_token_ctx;
     int32_t key_select = 0;
-    int i;
     int32_t cose_algorithm_id;
 
     attest_err = attest_get_t_cose_algorithm(&cose_algorithm_id);
@@ -684,14 +934,10 @@ attest_create_token(struct q_useful_buf_c *challenge,
         goto error;
     }
 
-    for (i = 0; i < ARRAY_LENGTH(claim_query_funcs); ++i)
+    attest_err = attest_add_all_claims(&attest_token_ctx);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
     {
-        /* Calling the attest_add_XXX_claim functions */
-        attest_err = claim_query_funcs[i](&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS)
-        {
-            goto error;
-        }
+        goto error;
     }
 
     /* Finish up creating the token. This is where the actual signature
@@ -777,8 +1023,26 @@ error:
     return error_mapping_to_psa_status_t(attest_err);
 }
 
+/*!
+ * \brief Static function to create the proof of execution token
+ *
+ * \param[in]  faddr            Address of the executed function
+ * \param[in]  execution_value  Value returned by the executed function
+ * \param[in]  challenge        Structure to carry the challenge value:
+ *                              pointer + challeng's length
+ * \param[in]  token            Structure to carry the token info, where to
+ *                              create it: pointer + buffer's length
+ * \param[out] completed_token  Structure to carry the info about the created
+ *                              token: pointer + final token's length
+ *
+ * \note The PoX claims are added to the same token as the nonce and the
+ *       platform claims, so a single signature covers all of them.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
 static enum psa_attest_err_t
-pox_create_token(uintptr_t *faddr,
+pox_create_token(uintptr_t faddr,
+                 int32_t execution_value,
                  struct q_useful_buf_c *challenge,
                  struct q_useful_buf *token,
                  struct q_useful_buf_c *completed_token)
@@ -787,9 +1051,7 @@ pox_create_token(uintptr_t *faddr,
     enum attest_token_err_t token_err;
     struct attest_token_encode_ctx attest_token_ctx;
     int32_t key_select = 0;
-    int i;
     int32_t cose_algorithm_id;
-    int execute_value;
 
     attest_err = attest_get_t_cose_algorithm(&cose_algorithm_id);
     if (attest_err != PSA_ATTEST_ERR_SUCCESS)
@@ -810,29 +1072,31 @@ pox_create_token(uintptr_t *faddr,
         attest_err = error_mapping_to_psa_attest_err_t(token_err);
         goto error;
     }
-    
-    execute_value = ns_execute(*faddr);
 
-    attest_err = attest_add_faddr(&attest_token_ctx,
-                                  faddr);
+    attest_err = attest_add_faddr(&attest_token_ctx, faddr);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
     attest_err = attest_add_execution_value(&attest_token_ctx,
-                                          execute_value);
+                                            execution_value);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
     attest_err = attest_add_nonce_claim(&attest_token_ctx,
                                         challenge);
-
     if (attest_err != PSA_ATTEST_ERR_SUCCESS)
     {
         goto error;
     }
 
-    for (i = 0; i < ARRAY_LENGTH(claim_query_funcs); ++i)
+    attest_err = attest_add_all_claims(&attest_token_ctx);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
     {
-        /* Calling the attest_add_XXX_claim functions */
-        attest_err = claim_query_funcs[i](&attest_token_ctx);
-        if (attest_err != PSA_ATTEST_ERR_SUCCESS)
-        {
-            goto error;
-        }
+        goto error;
     }
 
     /* Finish up creating the token. This is where the actual signature
@@ -849,6 +1113,21 @@ psa_status_t
 proof_of_execution(uintptr_t *faddr, const void *challenge_buf, size_t challenge_size,
                          void *token_buf, size_t token_buf_size,
                          size_t *token_size)
+{
+    int32_t execution_value;
+
+    execution_value = ns_execute(*faddr);
+
+    return proof_of_execution_result(*faddr, execution_value,
+                                     challenge_buf, challenge_size,
+                                     token_buf, token_buf_size, token_size);
+}
+
+psa_status_t
+proof_of_execution_result(uintptr_t faddr, int32_t execution_value,
+                          const void *challenge_buf, size_t challenge_size,
+                          void *token_buf, size_t token_buf_size,
+                          size_t *token_size)
 {
     enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
     struct q_useful_buf_c challenge;
@@ -872,7 +1151,121 @@ proof_of_execution(uintptr_t *faddr, const void *challenge_buf, size_t challenge
         goto error;
     }
 
-    attest_err = pox_create_token(faddr, &challenge, &token, &completed_token);
+    attest_err = pox_create_token(faddr, execution_value,
+                                  &challenge, &token, &completed_token);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
+    *token_size = completed_token.len;
+
+error:
+    return error_mapping_to_psa_status_t(attest_err);
+}
+
+/*!
+ * \brief Static function to create the proof of execution token of a batch
+ *
+ * \param[in]  entries          Results of the executions of the batch
+ * \param[in]  num_entries      Number of entries
+ * \param[in]  challenge        Structure to carry the challenge value:
+ *                              pointer + challeng's length
+ * \param[in]  token            Structure to carry the token info, where to
+ *                              create it: pointer + buffer's length
+ * \param[out] completed_token  Structure to carry the info about the created
+ *                              token: pointer + final token's length
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+pox_create_batch_token(const struct psa_pox_batch_entry_t *entries,
+                       size_t num_entries,
+                       struct q_useful_buf_c *challenge,
+                       struct q_useful_buf *token,
+                       struct q_useful_buf_c *completed_token)
+{
+    enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
+    enum attest_token_err_t token_err;
+    struct attest_token_encode_ctx attest_token_ctx;
+    int32_t key_select = 0;
+    int32_t cose_algorithm_id;
+
+    attest_err = attest_get_t_cose_algorithm(&cose_algorithm_id);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        return attest_err;
+    }
+
+    token_err = attest_token_encode_start(&attest_token_ctx,
+                                          key_select,        /* key_select   */
+                                          cose_algorithm_id, /* alg_select   */
+                                          token);
+
+    if (token_err != ATTEST_TOKEN_ERR_SUCCESS)
+    {
+        attest_err = error_mapping_to_psa_attest_err_t(token_err);
+        goto error;
+    }
+
+    attest_err = attest_add_pox_batch(&attest_token_ctx, entries, num_entries);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
+    attest_err = attest_add_nonce_claim(&attest_token_ctx,
+                                        challenge);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
+    attest_err = attest_add_all_claims(&attest_token_ctx);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
+    /* A single signature covers the results of the whole batch */
+    token_err = attest_token_encode_finish(&attest_token_ctx, completed_token);
+    attest_err = error_mapping_to_psa_attest_err_t(token_err);
+
+error:
+    return attest_err;
+}
+
+psa_status_t
+proof_of_execution_batch(const struct psa_pox_batch_entry_t *entries,
+                         size_t num_entries,
+                         const void *challenge_buf, size_t challenge_size,
+                         void *token_buf, size_t token_buf_size,
+                         size_t *token_size)
+{
+    enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
+    struct q_useful_buf_c challenge;
+    struct q_useful_buf token;
+    struct q_useful_buf_c completed_token;
+
+    challenge.ptr = challenge_buf;
+    challenge.len = challenge_size;
+    token.ptr = token_buf;
+    token.len = token_buf_size;
+
+    attest_err = attest_verify_challenge_size(challenge.len);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS)
+    {
+        goto error;
+    }
+
+    if ((token.len == 0) || (num_entries == 0))
+    {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    attest_err = pox_create_batch_token(entries, num_entries,
+                                        &challenge, &token, &completed_token);
     if (attest_err != PSA_ATTEST_ERR_SUCCESS)
     {
         goto error;
@@ -882,4 +1275,4 @@ proof_of_execution(uintptr_t *faddr, const void *challenge_buf, size_t challenge
 
 error:
     return error_mapping_to_psa_status_t(attest_err);
-}
\ No newline at end of file
+}
@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <stdbool.h>
 #include <string.h>
 
 #include "psa/error.h"
@@ -14,8 +15,10 @@
 #include "attest.h"
 
 #include "array.h"
+#include "config_tfm.h"
 #include "psa/framework_feature.h"
 #include "psa/service.h"
+#include "psa_manifest/pid.h"
 #include "psa_manifest/tfm_initial_attestation.h"
 #include "tfm_attest_defs.h"
 
@@ -131,6 +134,31 @@ static psa_status_t psa_attest_get_token_size(const psa_msg_t *msg)
     return status;
 }
 
+/*
+ * The PoX tokens are created directly in the client outvec when it can be
+ * mapped. Otherwise they are created in the static token buffer and copied.
+ */
+static void *pox_token_buff_get(const psa_msg_t *msg, size_t *size)
+{
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    *size = msg->out_size[0];
+    return psa_map_outvec(msg->handle, 0);
+#else
+    *size = (msg->out_size[0] < sizeof(token_buff)) ? msg->out_size[0] : sizeof(token_buff);
+    return token_buff;
+#endif
+}
+
+static void pox_token_buff_put(const psa_msg_t *msg, const void *buff, size_t token_size)
+{
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    (void)buff;
+    psa_unmap_outvec(msg->handle, 0, token_size);
+#else
+    psa_write(msg->handle, 0, buff, token_size);
+#endif
+}
+
 static psa_status_t psa_attest_proof_of_execution(const psa_msg_t *msg)
 {
     psa_status_t status = PSA_SUCCESS;
@@ -140,13 +168,18 @@ static psa_status_t psa_attest_proof_of_execution(const psa_msg_t *msg)
     size_t challenge_size;
     size_t token_buff_size;
     size_t token_size;
+    void *pox_token_buff;
     uintptr_t faddr;
 
     fadd_size = msg->in_size[0];
     challenge_size = msg->in_size[1];
-    token_buff_size = (msg->out_size[0] < sizeof(token_buff)) ? msg->out_size[0] : sizeof(token_buff);
 
-    if ((challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) || (challenge_size == 0) || (token_buff_size == 0))
+    if ((challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) || (challenge_size == 0) || (msg->out_size[0] == 0))
+    {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (fadd_size != sizeof(faddr))
     {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
@@ -164,14 +197,136 @@ static psa_status_t psa_attest_proof_of_execution(const psa_msg_t *msg)
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-    status = proof_of_execution(&faddr, challenge_buff, challenge_size, token_buff, token_buff_size, &token_size);
+    pox_token_buff = pox_token_buff_get(msg, &token_buff_size);
+    status = proof_of_execution(&faddr, challenge_buff, challenge_size, pox_token_buff, token_buff_size, &token_size);
     if (status == PSA_SUCCESS)
     {
-        psa_write(msg->handle, 0, token_buff, token_size);
+        pox_token_buff_put(msg, pox_token_buff, token_size);
+    }
+
+    return status;
+}
+
+/* The execution results are trusted as provided, so only the PoX partition,
+ * which executed the functions itself, can request tokens over them.
+ */
+static bool pox_result_caller_is_permitted(int32_t client_id)
+{
+#ifdef TFM_SP_POX
+    return client_id == TFM_SP_POX;
+#else
+    (void)client_id;
+    return false;
+#endif
+}
+
+static psa_status_t psa_attest_proof_of_execution_result(const psa_msg_t *msg)
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint8_t challenge_buff[PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+    uint32_t bytes_read = 0;
+    size_t challenge_size;
+    size_t token_buff_size;
+    size_t token_size;
+    void *pox_token_buff;
+    uintptr_t faddr;
+    int32_t execution_value;
+
+    if (!pox_result_caller_is_permitted(msg->client_id))
+    {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    challenge_size = msg->in_size[2];
+
+    if ((msg->in_size[0] != sizeof(faddr)) || (msg->in_size[1] != sizeof(execution_value)) ||
+        (challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) || (challenge_size == 0) || (msg->out_size[0] == 0))
+    {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* store the client ID here for later use in service */
+    g_attest_caller_id = msg->client_id;
+    bytes_read = psa_read(msg->handle, 0, &faddr, sizeof(faddr));
+    if (bytes_read != sizeof(faddr))
+    {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    bytes_read = psa_read(msg->handle, 1, &execution_value, sizeof(execution_value));
+    if (bytes_read != sizeof(execution_value))
+    {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    bytes_read = psa_read(msg->handle, 2, challenge_buff, challenge_size);
+    if (bytes_read != challenge_size)
+    {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    pox_token_buff = pox_token_buff_get(msg, &token_buff_size);
+    status = proof_of_execution_result(faddr, execution_value, challenge_buff, challenge_size,
+                                       pox_token_buff, token_buff_size, &token_size);
+    if (status == PSA_SUCCESS)
+    {
+        pox_token_buff_put(msg, pox_token_buff, token_size);
+    }
+
+    return status;
+}
+
+#if ATTEST_POX_BATCH_MAX_ENTRIES > 0
+static psa_status_t psa_attest_proof_of_execution_batch(const psa_msg_t *msg)
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint8_t challenge_buff[PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+    struct psa_pox_batch_entry_t entries[ATTEST_POX_BATCH_MAX_ENTRIES];
+    uint32_t bytes_read = 0;
+    size_t entries_size;
+    size_t challenge_size;
+    size_t token_buff_size;
+    size_t token_size;
+    void *pox_token_buff;
+
+    if (!pox_result_caller_is_permitted(msg->client_id))
+    {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    entries_size = msg->in_size[0];
+    challenge_size = msg->in_size[1];
+
+    if ((entries_size == 0) || (entries_size > sizeof(entries)) ||
+        ((entries_size % sizeof(entries[0])) != 0) ||
+        (challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) || (challenge_size == 0) || (msg->out_size[0] == 0))
+    {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* store the client ID here for later use in service */
+    g_attest_caller_id = msg->client_id;
+    bytes_read = psa_read(msg->handle, 0, entries, entries_size);
+    if (bytes_read != entries_size)
+    {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+    bytes_read = psa_read(msg->handle, 1, challenge_buff, challenge_size);
+    if (bytes_read != challenge_size)
+    {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    pox_token_buff = pox_token_buff_get(msg, &token_buff_size);
+    status = proof_of_execution_batch(entries, entries_size / sizeof(entries[0]),
+                                      challenge_buff, challenge_size,
+                                      pox_token_buff, token_buff_size, &token_size);
+    if (status == PSA_SUCCESS)
+    {
+        pox_token_buff_put(msg, pox_token_buff, token_size);
     }
 
     return status;
 }
+#endif /* ATTEST_POX_BATCH_MAX_ENTRIES > 0 */
 
 psa_status_t tfm_attestation_service_sfn(const psa_msg_t *msg)
 {
@@ -183,6 +338,12 @@ psa_status_t tfm_attestation_service_sfn(const psa_msg_t *msg)
         return psa_attest_get_token_size(msg);
     case TFM_ATTEST_GET_POX:
         return psa_attest_proof_of_execution(msg);
+    case TFM_ATTEST_GET_POX_RESULT:
+        return psa_attest_proof_of_execution_result(msg);
+#if ATTEST_POX_BATCH_MAX_ENTRIES > 0
+    case TFM_ATTEST_GET_POX_BATCH:
+        return psa_attest_proof_of_execution_batch(msg);
+#endif
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
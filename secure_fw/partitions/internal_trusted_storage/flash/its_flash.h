@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020-2022 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -32,6 +32,9 @@ extern uint8_t its_block_data[];
  * shot, so no filesystem data alignment is required.
  */
 #include "its_flash_nand.h"
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+#error "ITS_METADATA_JOURNAL_RECORDS requires flash which can be programmed in place"
+#endif
 extern struct its_flash_nand_dev_t its_flash_nand_dev;
 #define ITS_FLASH_DEV its_flash_nand_dev
 #define ITS_FLASH_ALIGNMENT 1
@@ -62,6 +65,9 @@ extern uint8_t ps_block_data[];
  * shot, so no filesystem data alignment is required.
  */
 #include "its_flash_nand.h"
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+#error "ITS_METADATA_JOURNAL_RECORDS requires flash which can be programmed in place"
+#endif
 extern struct its_flash_nand_dev_t ps_flash_nand_dev;
 #define PS_FLASH_DEV ps_flash_nand_dev
 #define PS_FLASH_ALIGNMENT 1
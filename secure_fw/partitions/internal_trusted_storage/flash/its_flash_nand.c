@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -33,6 +33,34 @@ static uint32_t get_phys_address(const struct its_flash_fs_config_t *cfg,
     return cfg->flash_area_addr + (block_id * cfg->block_size) + offset;
 }
 
+/**
+ * \brief Gets the write buffer of the given block ID, assigning an empty
+ *        write buffer to it if it has none.
+ *
+ * \param[in,out] flash_dev  NAND flash device
+ * \param[in]     block_id   Block ID
+ *
+ * \returns Returns the write buffer of the block, or NULL if both write buffers
+ *          are assigned to other blocks.
+ */
+static uint8_t *get_write_buf(struct its_flash_nand_dev_t *flash_dev,
+                              uint32_t block_id)
+{
+    if (block_id == flash_dev->buf_block_id_0) {
+        return flash_dev->write_buf_0;
+    } else if (block_id == flash_dev->buf_block_id_1) {
+        return flash_dev->write_buf_1;
+    } else if (flash_dev->buf_block_id_0 == ITS_BLOCK_INVALID_ID) {
+        flash_dev->buf_block_id_0 = block_id;
+        return flash_dev->write_buf_0;
+    } else if (flash_dev->buf_block_id_1 == ITS_BLOCK_INVALID_ID) {
+        flash_dev->buf_block_id_1 = block_id;
+        return flash_dev->write_buf_1;
+    } else {
+        return NULL;
+    }
+}
+
 static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
 {
     int32_t err;
@@ -144,6 +172,7 @@ static psa_status_t its_flash_nand_write(
 {
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    uint8_t *write_buf;
 
     if (block_id == ITS_BLOCK_INVALID_ID) {
         return PSA_ERROR_PROGRAMMER_ERROR;
@@ -152,20 +181,13 @@ static psa_status_t its_flash_nand_write(
     /* Write to the match block buffer if exists. Otherwise use the empty
      * buffer if exists. If no more empty buffer, return error.
      */
-    if (block_id == flash_dev->buf_block_id_0) {
-        (void)memcpy(flash_dev->write_buf_0 + offset, buff, size);
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        (void)memcpy(flash_dev->write_buf_1 + offset, buff, size);
-    } else if (flash_dev->buf_block_id_0 == ITS_BLOCK_INVALID_ID) {
-        flash_dev->buf_block_id_0 = block_id;
-        (void)memcpy(flash_dev->write_buf_0 + offset, buff, size);
-    } else if (flash_dev->buf_block_id_1 == ITS_BLOCK_INVALID_ID) {
-        flash_dev->buf_block_id_1 = block_id;
-        (void)memcpy(flash_dev->write_buf_1 + offset, buff, size);
-    } else {
+    write_buf = get_write_buf(flash_dev, block_id);
+    if (write_buf == NULL) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    (void)memcpy(write_buf + offset, buff, size);
+
     return PSA_SUCCESS;
 }
 
@@ -239,10 +261,37 @@ static psa_status_t its_flash_nand_erase(const struct its_flash_fs_config_t *cfg
     return PSA_SUCCESS;
 }
 
+static psa_status_t its_flash_nand_copy(
+                                    const struct its_flash_fs_config_t *cfg,
+                                    uint32_t dst_block, size_t dst_offset,
+                                    uint32_t src_block, size_t src_offset,
+                                    size_t size)
+{
+    struct its_flash_nand_dev_t *flash_dev =
+        (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    uint8_t *write_buf;
+
+    if (dst_block == ITS_BLOCK_INVALID_ID) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    write_buf = get_write_buf(flash_dev, dst_block);
+    if (write_buf == NULL) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* Read the source data straight into the destination block's write
+     * buffer, in a single read of the flash device.
+     */
+    return its_flash_nand_read(cfg, src_block, write_buf + dst_offset,
+                               src_offset, size);
+}
+
 const struct its_flash_fs_ops_t its_flash_fs_ops_nand = {
     .init = its_flash_nand_init,
     .read = its_flash_nand_read,
     .write = its_flash_nand_write,
     .flush = its_flash_nand_flush,
     .erase = its_flash_nand_erase,
+    .copy = its_flash_nand_copy,
 };
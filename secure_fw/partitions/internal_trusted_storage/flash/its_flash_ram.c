@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -76,10 +76,25 @@ static psa_status_t its_flash_ram_erase(const struct its_flash_fs_config_t *cfg,
     return PSA_SUCCESS;
 }
 
+static psa_status_t its_flash_ram_copy(const struct its_flash_fs_config_t *cfg,
+                                       uint32_t dst_block, size_t dst_offset,
+                                       uint32_t src_block, size_t src_offset,
+                                       size_t size)
+{
+    uint32_t dst_idx = get_phys_address(cfg, dst_block, dst_offset);
+    uint32_t src_idx = get_phys_address(cfg, src_block, src_offset);
+
+    (void)memcpy((uint8_t *)cfg->flash_dev + dst_idx,
+                 (uint8_t *)cfg->flash_dev + src_idx, size);
+
+    return PSA_SUCCESS;
+}
+
 const struct its_flash_fs_ops_t its_flash_fs_ops_ram = {
     .init = its_flash_ram_init,
     .read = its_flash_ram_read,
     .write = its_flash_ram_write,
     .flush = its_flash_ram_flush,
     .erase = its_flash_ram_erase,
+    .copy = its_flash_ram_copy,
 };
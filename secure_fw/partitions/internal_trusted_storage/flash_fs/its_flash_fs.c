@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -22,25 +22,19 @@
 
 static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
                                             uint32_t del_file_idx);
+#if ITS_DEFERRED_COMPACTION
+static psa_status_t its_flash_fs_compact_for(struct its_flash_fs_ctx_t *fs_ctx,
+                                             size_t size);
+#endif
 
-static psa_status_t its_flash_fs_file_write_aligned_data(
+static psa_status_t its_flash_fs_file_write_data(
                                       struct its_flash_fs_ctx_t *fs_ctx,
                                       const struct its_block_meta_t *block_meta,
                                       const struct its_file_meta_t *file_meta,
                                       size_t offset,
                                       size_t size,
-                                      const uint8_t *data)
+                                      struct its_flash_fs_dblock_src_t *src)
 {
-#if (ITS_FLASH_MAX_ALIGNMENT != 1)
-    /* Check that the offset is aligned with the flash program unit */
-    if (!ITS_UTILS_IS_ALIGNED(offset, fs_ctx->cfg->program_unit)) {
-        return PSA_ERROR_INVALID_ARGUMENT;
-    }
-
-    /* Set the size to be aligned with the flash program unit */
-    size = ITS_UTILS_ALIGN(size, fs_ctx->cfg->program_unit);
-#endif
-
     /* It is not permitted to create gaps in the file */
     if (offset > file_meta->cur_size) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -53,7 +47,7 @@ static psa_status_t its_flash_fs_file_write_aligned_data(
     }
 
     return its_flash_fs_dblock_write_file(fs_ctx, block_meta, file_meta, offset,
-                                          size, data);
+                                          size, src);
 }
 
 /* TODO This is very similar to (static) its_num_active_dblocks() */
@@ -84,7 +78,8 @@ static size_t its_flash_fs_all_metadata_size(
     return sizeof(struct its_metadata_block_header_t)
            + (its_flash_fs_num_active_dblocks(cfg)
               * sizeof(struct its_block_meta_t))
-           + (cfg->max_num_files * sizeof(struct its_file_meta_t));
+           + (cfg->max_num_files * sizeof(struct its_file_meta_t))
+           + ITS_METADATA_JOURNAL_SIZE;
 }
 
 /**
@@ -220,12 +215,25 @@ psa_status_t its_flash_fs_file_get_info(struct its_flash_fs_ctx_t *fs_ctx,
     return PSA_SUCCESS;
 }
 
-psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
-                                     const uint8_t *fid,
-                                     struct its_flash_fs_file_info_t *finfo,
-                                     size_t data_size,
-                                     size_t offset,
-                                     const uint8_t *data)
+/**
+ * \brief Writes data from a data source to a file.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     fid        File ID
+ * \param[in]     finfo      Pointer to \ref its_flash_fs_file_info_t
+ * \param[in]     data_size  Size of the incoming write data
+ * \param[in]     offset     Offset in the file to write
+ * \param[in,out] src        Source of the data to be written
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_file_write_src(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        const uint8_t *fid,
+                                        struct its_flash_fs_file_info_t *finfo,
+                                        size_t data_size,
+                                        size_t offset,
+                                        struct its_flash_fs_dblock_src_t *src)
 {
     struct its_block_meta_t block_meta;
     struct its_file_meta_t file_meta = {0};
@@ -250,6 +258,10 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
     finfo->size_max = ITS_UTILS_ALIGN(finfo->size_max, fs_ctx->cfg->program_unit);
 #endif
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    its_flash_fs_mblock_meta_update_start(fs_ctx);
+#endif
+
     /* Check if the file already exists */
     err = its_flash_fs_mblock_get_file_idx_meta(fs_ctx, fid, &old_idx, &file_meta);
     if (err == PSA_SUCCESS) {
@@ -262,6 +274,7 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
                 file_meta.flags = finfo->flags;
                 new_idx = old_idx;
             } else {
+#if !ITS_DEFERRED_COMPACTION
                 /* Mark the existing file to be deleted in this block update. It
                  * will be deleted in a second block update, and if there is a
                  * power failure before that block update completes, then
@@ -274,6 +287,7 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
                 if (err != PSA_SUCCESS) {
                     return PSA_ERROR_GENERIC_ERROR;
                 }
+#endif /* !ITS_DEFERRED_COMPACTION */
             }
         } else {
             /* Write to existing file */
@@ -302,9 +316,38 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         err = its_flash_fs_mblock_reserve_file(fs_ctx, fid, use_spare,
                                                finfo->size_max, finfo->flags, &new_idx,
                                                &file_meta, &block_meta);
+#if ITS_DEFERRED_COMPACTION
+        if (err == PSA_ERROR_INSUFFICIENT_STORAGE) {
+            /* Release the space left by deleted files and retry. Nothing has
+             * been written to the scratch metadata block yet.
+             */
+            err = its_flash_fs_compact_for(fs_ctx, finfo->size_max);
+            if (err == PSA_SUCCESS) {
+                err = its_flash_fs_mblock_reserve_file(fs_ctx, fid, use_spare,
+                                                       finfo->size_max,
+                                                       finfo->flags, &new_idx,
+                                                       &file_meta, &block_meta);
+            }
+        }
+#endif /* ITS_DEFERRED_COMPACTION */
         if (err != PSA_SUCCESS) {
             return err;
         }
+
+#if ITS_DEFERRED_COMPACTION
+        if (old_idx != ITS_METADATA_INVALID_INDEX) {
+            struct its_file_meta_t del_file_meta = {0};
+
+            /* Delete the existing file in this block update. The space used by
+             * its data is released when the block is compacted.
+             */
+            err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, old_idx,
+                                                               &del_file_meta);
+            if (err != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+        }
+#endif /* ITS_DEFERRED_COMPACTION */
     } else {
         /* Read existing block metadata */
         err = its_flash_fs_mblock_read_block_metadata(fs_ctx, file_meta.lblock,
@@ -316,9 +359,8 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
 
     if (data_size != 0) {
         /* Write the content into scratch data block */
-        err = its_flash_fs_file_write_aligned_data(fs_ctx, &block_meta,
-                                                   &file_meta, offset,
-                                                   data_size, data);
+        err = its_flash_fs_file_write_data(fs_ctx, &block_meta, &file_meta,
+                                           offset, data_size, src);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
         }
@@ -408,6 +450,7 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
         return err;
     }
 
+#if !ITS_DEFERRED_COMPACTION
     /* Delete the old file in a second block update.
      * Note: A power failure after this point, but before the deletion has
      * completed, will leave the old file in the filesystem, so it is always
@@ -416,85 +459,165 @@ psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
     if (old_idx != ITS_METADATA_INVALID_INDEX && old_idx != new_idx) {
         err = its_flash_fs_delete_idx(fs_ctx, old_idx);
     }
+#endif /* !ITS_DEFERRED_COMPACTION */
 
     return err;
 }
 
-static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
-                                            uint32_t del_file_idx)
+psa_status_t its_flash_fs_file_write(struct its_flash_fs_ctx_t *fs_ctx,
+                                     const uint8_t *fid,
+                                     struct its_flash_fs_file_info_t *finfo,
+                                     size_t data_size,
+                                     size_t offset,
+                                     const uint8_t *data)
 {
-    size_t del_file_data_idx;
-    uint32_t del_file_lblock;
-    size_t del_file_max_size;
+    struct its_flash_fs_dblock_src_t src = {
+        .data = data,
+    };
+
+    return its_flash_fs_file_write_src(fs_ctx, fid, finfo, data_size, offset,
+                                       &src);
+}
+
+psa_status_t its_flash_fs_file_write_stream(struct its_flash_fs_ctx_t *fs_ctx,
+                                            const uint8_t *fid,
+                                            struct its_flash_fs_file_info_t *finfo,
+                                            size_t data_size,
+                                            size_t offset,
+                                            its_flash_fs_read_data_t read_data,
+                                            uint8_t *buf,
+                                            size_t buf_size)
+{
+    struct its_flash_fs_dblock_src_t src = {
+        .read_data = read_data,
+        .buf = buf,
+        /* Only stage whole program units */
+        .buf_size = buf_size - (buf_size % fs_ctx->cfg->program_unit),
+    };
+
+    if ((read_data == NULL) || (buf == NULL) || (src.buf_size == 0)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    return its_flash_fs_file_write_src(fs_ctx, fid, finfo, data_size, offset,
+                                       &src);
+}
+
+#if ITS_DEFERRED_COMPACTION
+/**
+ * \brief Gets the number of bytes used by the files stored in a logical block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     lblock  Logical data block
+ * \param[out]    size    Number of bytes used
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_used_size(struct its_flash_fs_ctx_t *fs_ctx,
+                                           uint32_t lblock,
+                                           size_t *size)
+{
+    struct its_file_meta_t file_meta;
     psa_status_t err;
-    size_t src_offset = fs_ctx->cfg->block_size;
-    size_t nbr_bytes_to_move = 0;
     uint32_t idx;
-    struct its_file_meta_t file_meta;
-    struct its_block_meta_t block_meta;
 
-    err = its_flash_fs_mblock_read_file_meta(fs_ctx, del_file_idx, &file_meta);
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
+    *size = 0;
 
-    if (its_utils_validate_fid(file_meta.id) != PSA_SUCCESS) {
-        return PSA_ERROR_DOES_NOT_EXIST;
+    for (idx = 0; idx < fs_ctx->cfg->max_num_files; idx++) {
+        err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &file_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if ((file_meta.lblock == lblock) &&
+            (its_utils_validate_fid(file_meta.id) == PSA_SUCCESS)) {
+            *size += file_meta.max_size;
+        }
     }
 
-    /* Save logical block, data_index and max_size to be used later on */
-    del_file_lblock = file_meta.lblock;
-    del_file_data_idx = file_meta.data_idx;
-    del_file_max_size = file_meta.max_size;
+    return PSA_SUCCESS;
+}
+#endif /* ITS_DEFERRED_COMPACTION */
+
+/**
+ * \brief Updates the metadata of the filesystem, optionally deleting a file
+ *        and compacting the logical block it is stored in.
+ *
+ * \details When the block is compacted, the data of the files it contains is
+ *          packed at the start of the block, which releases the space left by
+ *          the deleted file and by any file deleted without compaction.
+ *
+ * \param[in,out] fs_ctx        Filesystem context
+ * \param[in]     lblock        Logical data block to compact
+ * \param[in]     del_file_idx  Index of the file to delete, or
+ *                              ITS_METADATA_INVALID_INDEX
+ * \param[in]     compact       Whether to compact the logical block
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_update_block(struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t lblock,
+                                              uint32_t del_file_idx,
+                                              bool compact)
+{
+    struct its_block_meta_t block_meta;
+    struct its_file_meta_t file_meta;
+    psa_status_t err;
+    size_t used_size = 0;
+    size_t new_data_idx;
+    uint32_t idx;
 
-    /* Remove file metadata */
-    file_meta = (struct its_file_meta_t){0};
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    its_flash_fs_mblock_meta_update_start(fs_ctx);
+#endif
 
-    /* Update file metadata in to the scratch block */
-    err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, del_file_idx,
-                                                       &file_meta);
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock, &block_meta);
     if (err != PSA_SUCCESS) {
         return err;
     }
 
-    /* Read all file metadata */
     for (idx = 0; idx < fs_ctx->cfg->max_num_files; idx++) {
-        if (idx == del_file_idx) {
-            /* Skip deleted file */
+        if (!compact && (idx != del_file_idx)) {
+            /* Only the deleted file's metadata is modified, the other entries
+             * are copied once the block metadata is updated.
+             */
             continue;
         }
 
-        /* Read file meta for the given file index */
-        err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &file_meta);
-        if (err != PSA_SUCCESS) {
-            return err;
-        }
+        if (idx == del_file_idx) {
+            /* Remove file metadata */
+            file_meta = (struct its_file_meta_t){0};
+        } else {
+            /* Read file meta for the given file index */
+            err = its_flash_fs_mblock_read_file_meta(fs_ctx, idx, &file_meta);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
 
-        /* Check if the file is located in the same logical block and has a
-         * valid FID.
-         */
-        if ((file_meta.lblock == del_file_lblock) &&
-            (its_utils_validate_fid(file_meta.id) == PSA_SUCCESS)) {
-            /* If a file is located after the data to delete, this
-             * needs to be moved.
+            /* Pack the data of the files located in the compacted block in
+             * file metadata entry order. The data is moved from the active
+             * block to the scratch block, so the files can be placed in any
+             * order, and the new data index of each file is the size used by
+             * the files packed before it.
              */
-            if (file_meta.data_idx > del_file_data_idx) {
-                /* Check if this is the position after the deleted
-                 * data. This will be the first file data to move.
-                 */
-                if (src_offset > file_meta.data_idx) {
-                    src_offset = file_meta.data_idx;
+            if (compact && (file_meta.lblock == lblock) &&
+                (its_utils_validate_fid(file_meta.id) == PSA_SUCCESS)) {
+                new_data_idx = block_meta.data_start + used_size;
+
+                err = its_flash_fs_dblock_move_file(fs_ctx, lblock,
+                                                    file_meta.data_idx,
+                                                    new_data_idx,
+                                                    file_meta.max_size);
+                if (err != PSA_SUCCESS) {
+                    return PSA_ERROR_GENERIC_ERROR;
                 }
 
-                /* Set the new file data index location in the
-                 * data block.
-                 */
-                file_meta.data_idx -= del_file_max_size;
-
-                /* Increase number of bytes to move */
-                nbr_bytes_to_move += file_meta.max_size;
+                /* Set the new file data index location in the data block */
+                file_meta.data_idx = new_data_idx;
+                used_size += file_meta.max_size;
             }
         }
+
         /* Update file metadata in to the scratch block */
         err = its_flash_fs_mblock_update_scratch_file_meta(fs_ctx, idx,
                                                            &file_meta);
@@ -503,42 +626,46 @@ static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
         }
     }
 
-    if (del_file_max_size == 0) {
-        /* If the asset max size is 0, there is no need to compact the data block.
-         * Copy the block metadata and the block data to scratch metadata block.
+    if (compact) {
+        /* Compact data block */
+        err = its_flash_fs_dblock_compact_block(fs_ctx, lblock, used_size);
+    } else {
+        /* Copy the block metadata to the scratch metadata block. The data
+         * blocks are left untouched.
          */
-        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, ITS_LOGICAL_DBLOCK0, &block_meta);
+        err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx, lblock,
+                                                            &block_meta);
         if (err != PSA_SUCCESS) {
             return err;
         }
-        err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx, ITS_LOGICAL_DBLOCK0,
-                                                            &block_meta);
-    } else {
-        /* Compact data block */
-        err = its_flash_fs_dblock_compact_block(fs_ctx, del_file_lblock,
-                                                del_file_max_size,
-                                                src_offset, del_file_data_idx,
-                                                nbr_bytes_to_move);
+
+        /* Copy the file metadata entries around the deleted one */
+        err = its_flash_fs_mblock_cp_file_meta(fs_ctx, 0, del_file_idx);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+
+        err = its_flash_fs_mblock_cp_file_meta(fs_ctx, del_file_idx + 1,
+                                               fs_ctx->cfg->max_num_files);
     }
 
     if (err != PSA_SUCCESS) {
         return err;
     }
 
-    /* If the max size of file to delete is not 0:
+    /* If the block is compacted:
      * The file data in the logical block 0 is stored in same physical block
      * where the metadata is stored. A change in the metadata requires a
      * swap of physical blocks. So, the file data stored in the current
      * metadata block needs to be copied in the scratch block, if the data
-     * of the file processed is not located in the logical block 0. When an
-     * file data is located in the logical block 0, that copy has been done
-     * while processing the file data.
-     * If the max size of file to delete is 0:
+     * of the block compacted is not located in the logical block 0. When the
+     * logical block 0 is compacted, that copy has been done while moving the
+     * file data.
+     * If the block is not compacted:
      * The file metadata and block metadata has been updated into the scratch
      * metadata block, copy the file data to the scratch block.
      */
-    if ((del_file_max_size != 0 && del_file_lblock != ITS_LOGICAL_DBLOCK0) ||
-        (del_file_max_size == 0)) {
+    if (!compact || (lblock != ITS_LOGICAL_DBLOCK0)) {
         err = its_flash_fs_mblock_migrate_lb0_data_to_scratch(fs_ctx);
         if (err != PSA_SUCCESS) {
             return PSA_ERROR_GENERIC_ERROR;
@@ -551,6 +678,83 @@ static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
     return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
 }
 
+#if ITS_DEFERRED_COMPACTION
+/**
+ * \brief Compacts a logical block, so that a file of the given size can be
+ *        reserved in it.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     size    Size of the file to reserve
+ *
+ * \return Returns PSA_ERROR_INSUFFICIENT_STORAGE if compacting a block would
+ *         not leave enough space for the file, otherwise error code as
+ *         specified in \ref psa_status_t
+ */
+static psa_status_t its_flash_fs_compact_for(struct its_flash_fs_ctx_t *fs_ctx,
+                                             size_t size)
+{
+    struct its_block_meta_t block_meta;
+    psa_status_t err;
+    size_t used_size;
+    uint32_t lblock;
+
+    for (lblock = 0; lblock < its_flash_fs_num_active_dblocks(fs_ctx->cfg);
+         lblock++) {
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock,
+                                                      &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if (block_meta.free_size >= size) {
+            /* The space is not the issue */
+            return PSA_ERROR_INSUFFICIENT_STORAGE;
+        }
+
+        err = its_flash_fs_used_size(fs_ctx, lblock, &used_size);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if ((fs_ctx->cfg->block_size - block_meta.data_start) - used_size
+            >= size) {
+            return its_flash_fs_update_block(fs_ctx, lblock,
+                                             ITS_METADATA_INVALID_INDEX, true);
+        }
+    }
+
+    return PSA_ERROR_INSUFFICIENT_STORAGE;
+}
+#endif /* ITS_DEFERRED_COMPACTION */
+
+static psa_status_t its_flash_fs_delete_idx(struct its_flash_fs_ctx_t *fs_ctx,
+                                            uint32_t del_file_idx)
+{
+    psa_status_t err;
+    struct its_file_meta_t file_meta;
+
+    err = its_flash_fs_mblock_read_file_meta(fs_ctx, del_file_idx, &file_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (its_utils_validate_fid(file_meta.id) != PSA_SUCCESS) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+#if ITS_DEFERRED_COMPACTION
+    /* Only remove the file metadata. The space used by the file data is
+     * released when the block is compacted to make space for a new file.
+     */
+    return its_flash_fs_update_block(fs_ctx, file_meta.lblock, del_file_idx,
+                                     false);
+#else
+    /* If the asset max size is 0, there is no need to compact the data block */
+    return its_flash_fs_update_block(fs_ctx, file_meta.lblock, del_file_idx,
+                                     file_meta.max_size != 0);
+#endif
+}
+
 psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
                                       const uint8_t *fid)
 {
@@ -597,3 +801,37 @@ psa_status_t its_flash_fs_file_read(struct its_flash_fs_ctx_t *fs_ctx,
 
     return PSA_SUCCESS;
 }
+
+psa_status_t its_flash_fs_file_read_stream(struct its_flash_fs_ctx_t *fs_ctx,
+                                           const uint8_t *fid,
+                                           size_t size,
+                                           size_t offset,
+                                           its_flash_fs_write_data_t write_data,
+                                           uint8_t *buf,
+                                           size_t buf_size)
+{
+    psa_status_t err;
+    uint32_t idx;
+    struct its_file_meta_t tmp_metadata;
+
+    if ((write_data == NULL) || (buf == NULL) || (buf_size == 0)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Get the file index and meta data */
+    err = its_flash_fs_mblock_get_file_idx_meta(fs_ctx, fid, &idx, &tmp_metadata);
+    if (err != PSA_SUCCESS) {
+        return PSA_ERROR_DOES_NOT_EXIST;
+    }
+
+    /* Boundary check the incoming request */
+    err = its_utils_check_contained_in(tmp_metadata.cur_size, offset, size);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Read the file from flash and pass it on chunk by chunk */
+    return its_flash_fs_dblock_read_file_stream(fs_ctx, &tmp_metadata, offset,
+                                                size, write_data, buf,
+                                                buf_size);
+}
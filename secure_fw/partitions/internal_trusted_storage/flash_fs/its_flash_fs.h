@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -153,6 +153,35 @@ struct its_flash_fs_ops_t {
      */
     psa_status_t (*erase)(const struct its_flash_fs_config_t *cfg,
                           uint32_t block_id);
+
+    /**
+     * \brief Copies data from the position specified by source block ID and
+     *        offset to the position specified by destination block ID and
+     *        offset.
+     *
+     * \param[in] cfg         Filesystem configuration
+     * \param[in] dst_block   Destination block ID
+     * \param[in] dst_offset  Offset position from the init of the destination
+     *                        block
+     * \param[in] src_block   Source block ID
+     * \param[in] src_offset  Offset position from the init of the source block
+     * \param[in] size        Number of bytes to copy
+     *
+     * \note This function is optional and may be NULL, in which case the data
+     *       is copied with read() and write() through a buffer of
+     *       ITS_MAX_BLOCK_DATA_COPY bytes. The destination is written as by
+     *       write(), and the source and destination blocks are different.
+     *
+     * \note This function assumes all input values are valid. That is, the
+     *       address ranges, based on block IDs, offsets and size, are valid
+     *       ranges in flash.
+     *
+     * \return Returns PSA_SUCCESS if the function is executed correctly.
+     *         Otherwise, it returns PSA_ERROR_STORAGE_FAILURE.
+     */
+    psa_status_t (*copy)(const struct its_flash_fs_config_t *cfg,
+                         uint32_t dst_block, size_t dst_offset,
+                         uint32_t src_block, size_t src_offset, size_t size);
 };
 
 /**
@@ -166,6 +195,29 @@ struct its_flash_fs_ops_t {
  */
 typedef struct its_flash_fs_ctx_t its_flash_fs_ctx_t;
 
+/**
+ * \brief Callback which provides the next part of the data written to a file
+ *        by \ref its_flash_fs_file_write_stream.
+ *
+ * \param[out] buf   Buffer to store the data
+ * \param[in]  size  Number of bytes to provide
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+typedef psa_status_t (*its_flash_fs_read_data_t)(uint8_t *buf, size_t size);
+
+/**
+ * \brief Callback which consumes the next part of the data read from a file
+ *        by \ref its_flash_fs_file_read_stream.
+ *
+ * \param[in] buf   Buffer containing the data
+ * \param[in] size  Number of bytes in the buffer
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+typedef psa_status_t (*its_flash_fs_write_data_t)(const uint8_t *buf,
+                                                  size_t size);
+
 /*!
  * \struct its_flash_fs_file_info_t
  *
@@ -258,6 +310,35 @@ psa_status_t its_flash_fs_file_write(its_flash_fs_ctx_t *fs_ctx,
                                      size_t offset,
                                      const uint8_t *data);
 
+/**
+ * \brief Writes data to a file, getting the data in chunks from a callback.
+ *
+ * \details The data is staged in the given buffer in chunks no larger than
+ *          the buffer, and the file is updated atomically with a single
+ *          metadata block update whatever the number of chunks.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     fid        File ID
+ * \param[in]     finfo      Pointer to \ref its_flash_fs_file_info_t
+ * \param[in]     data_size  Size of the incoming write data.
+ * \param[in]     offset     Offset in the file to write. Must be less than or
+ *                           equal to the current file size.
+ * \param[in]     read_data  Callback providing the data to be written
+ * \param[in]     buf        Buffer to stage the data
+ * \param[in]     buf_size   Size of the buffer. Must be at least the flash
+ *                           program unit.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_file_write_stream(its_flash_fs_ctx_t *fs_ctx,
+                                            const uint8_t *fid,
+                                            struct its_flash_fs_file_info_t *finfo,
+                                            size_t data_size,
+                                            size_t offset,
+                                            its_flash_fs_read_data_t read_data,
+                                            uint8_t *buf,
+                                            size_t buf_size);
+
 /**
  * \brief Reads data from an existing file.
  *
@@ -275,9 +356,34 @@ psa_status_t its_flash_fs_file_read(its_flash_fs_ctx_t *fs_ctx,
                                     size_t offset,
                                     uint8_t *data);
 
+/**
+ * \brief Reads data from an existing file, passing it in chunks to a callback.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     fid         File ID
+ * \param[in]     size        Size to be read
+ * \param[in]     offset      Offset in the file
+ * \param[in]     write_data  Callback consuming the data read
+ * \param[in]     buf         Buffer to stage the data
+ * \param[in]     buf_size    Size of the buffer
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_file_read_stream(its_flash_fs_ctx_t *fs_ctx,
+                                           const uint8_t *fid,
+                                           size_t size,
+                                           size_t offset,
+                                           its_flash_fs_write_data_t write_data,
+                                           uint8_t *buf,
+                                           size_t buf_size);
+
 /**
  * \brief Deletes file referenced by the file ID.
  *
+ * \note When ITS_DEFERRED_COMPACTION is enabled, the space used by the file
+ *       data is only released when the data block is compacted, the next time
+ *       a file cannot be created for lack of space.
+ *
  * \param[in,out] fs_ctx  Filesystem context
  * \param[in]     fid     File ID
  *
@@ -1,13 +1,16 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
 
+#include <string.h>
+
 #include "its_flash_fs_dblock.h"
 
 #include "its_flash_fs.h"
+#include "its_utils.h"
 
 /**
  * \brief Converts logical data block number to physical number.
@@ -31,18 +34,38 @@ static uint32_t its_dblock_lo_to_phy(struct its_flash_fs_ctx_t *fs_ctx,
     return block_meta.phy_id;
 }
 
+psa_status_t its_flash_fs_dblock_move_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                           uint32_t lblock,
+                                           size_t src_idx,
+                                           size_t dst_idx,
+                                           size_t size)
+{
+    uint32_t phys_block;
+    uint32_t scratch_id;
+
+    if (size == 0) {
+        return PSA_SUCCESS;
+    }
+
+    phys_block = its_dblock_lo_to_phy(fs_ctx, lblock);
+    if (phys_block == ITS_BLOCK_INVALID_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    scratch_id = its_flash_fs_mblock_cur_data_scratch_id(fs_ctx, lblock);
+
+    return its_flash_fs_block_to_block_move(fs_ctx, scratch_id, dst_idx,
+                                            phys_block, src_idx, size);
+}
+
 psa_status_t its_flash_fs_dblock_compact_block(
                                               struct its_flash_fs_ctx_t *fs_ctx,
                                               uint32_t lblock,
-                                              size_t free_size,
-                                              size_t src_offset,
-                                              size_t dst_offset,
-                                              size_t size)
+                                              size_t used_size)
 {
     struct its_block_meta_t block_meta;
     psa_status_t err;
     uint32_t scratch_id = 0;
-    int8_t flush_data = 0;
 
     /* Read current block meta */
     err = its_flash_fs_mblock_read_block_metadata(fs_ctx, lblock, &block_meta);
@@ -50,44 +73,16 @@ psa_status_t its_flash_fs_dblock_compact_block(
         return err;
     }
 
-    /* Release data from block meta */
-    block_meta.free_size += free_size;
+    /* Release the data not used by any file */
+    block_meta.free_size = (fs_ctx->cfg->block_size - block_meta.data_start)
+                           - used_size;
 
     /* Save scratch data block physical IDs */
     scratch_id = its_flash_fs_mblock_cur_data_scratch_id(fs_ctx, lblock);
 
-    /* Check if there are bytes to be compacted */
-    if (size > 0) {
-        /* Move data from source offset in current data block to scratch block
-         * destination offset.
-         */
-        err = its_flash_fs_block_to_block_move(fs_ctx, scratch_id, dst_offset,
-                                               block_meta.phy_id, src_offset,
-                                               size);
-        if (err != PSA_SUCCESS) {
-            return PSA_ERROR_GENERIC_ERROR;
-        }
-        flush_data = 1;
-    }
-
-    if (dst_offset > block_meta.data_start) {
-        /* Copy data from the beginning of data block until
-         * the position where the data will be reallocated later
-         */
-        err = its_flash_fs_block_to_block_move(fs_ctx, scratch_id,
-                                               block_meta.data_start,
-                                               block_meta.phy_id,
-                                               block_meta.data_start,
-                                              dst_offset-block_meta.data_start);
-        if (err != PSA_SUCCESS) {
-            return PSA_ERROR_GENERIC_ERROR;
-        }
-        flush_data = 1;
-    }
-
-    /* Swap the scratch and current data blocks. Must swap even with nothing
-     * to compact so that deleted file is left in scratch and erased as part
-     * of finalization.
+    /* Swap the scratch and current data blocks. Must swap even with no file
+     * data left so that deleted file is left in scratch and erased as part of
+     * finalization.
      */
     its_flash_fs_mblock_set_data_scratch(fs_ctx, block_meta.phy_id, lblock);
 
@@ -107,7 +102,7 @@ psa_status_t its_flash_fs_dblock_compact_block(
      * data block 0, in which case it will be flushed at the end of the metadata
      * block update.
      */
-    if ((lblock != ITS_LOGICAL_DBLOCK0) && (flush_data != 0)) {
+    if ((lblock != ITS_LOGICAL_DBLOCK0) && (used_size != 0)) {
         err = fs_ctx->ops->flush(fs_ctx->cfg, scratch_id);
     }
 
@@ -134,17 +129,160 @@ psa_status_t its_flash_fs_dblock_read_file(
     return fs_ctx->ops->read(fs_ctx->cfg, phys_block, buf, pos, size);
 }
 
+psa_status_t its_flash_fs_dblock_read_file_stream(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        const struct its_file_meta_t *file_meta,
+                                        size_t offset,
+                                        size_t size,
+                                        its_flash_fs_write_data_t write_data,
+                                        uint8_t *buf,
+                                        size_t buf_size)
+{
+    psa_status_t err;
+    uint32_t phys_block;
+    size_t pos;
+    size_t num_bytes;
+
+    phys_block = its_dblock_lo_to_phy(fs_ctx, file_meta->lblock);
+    if (phys_block == ITS_BLOCK_INVALID_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    pos = (file_meta->data_idx + offset);
+
+    while (size > 0) {
+        num_bytes = ITS_UTILS_MIN(size, buf_size);
+
+        err = fs_ctx->ops->read(fs_ctx->cfg, phys_block, buf, pos, num_bytes);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = write_data(buf, num_bytes);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        pos += num_bytes;
+        size -= num_bytes;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the next part of the data from a data source.
+ *
+ * \param[in,out] src   Data source
+ * \param[out]    buf   Buffer to store the data
+ * \param[in]     size  Number of bytes to get
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_dblock_src_get(struct its_flash_fs_dblock_src_t *src,
+                                       uint8_t *buf, size_t size)
+{
+    if (src->data == NULL) {
+        return src->read_data(buf, size);
+    }
+
+    (void)memcpy(buf, src->data, size);
+    src->data += size;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes data from a data source to the scratch data block.
+ *
+ * \details Program units only partly covered by the data are completed with
+ *          the content of the current data block at the same position.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     scratch_id  Physical ID of the scratch data block
+ * \param[in]     cur_id      Physical ID of the current data block
+ * \param[in]     pos         Position in the block where to write the data
+ * \param[in]     size        Number of bytes to write
+ * \param[in,out] src         Data source
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_dblock_write_src(struct its_flash_fs_ctx_t *fs_ctx,
+                                         uint32_t scratch_id,
+                                         uint32_t cur_id,
+                                         size_t pos,
+                                         size_t size,
+                                         struct its_flash_fs_dblock_src_t *src)
+{
+    const size_t program_unit = fs_ctx->cfg->program_unit;
+    uint8_t unit_buf[ITS_FLASH_MAX_ALIGNMENT];
+    size_t unit_offset;
+    size_t num_bytes;
+    psa_status_t err;
+
+    while (size > 0) {
+        unit_offset = pos % program_unit;
+
+        if ((unit_offset != 0) || (size < program_unit)) {
+            /* Merge the data with the current content of the program unit */
+            num_bytes = ITS_UTILS_MIN(size, program_unit - unit_offset);
+
+            err = fs_ctx->ops->read(fs_ctx->cfg, cur_id, unit_buf,
+                                    pos - unit_offset, program_unit);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            err = its_dblock_src_get(src, unit_buf + unit_offset, num_bytes);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, unit_buf,
+                                     pos - unit_offset, program_unit);
+        } else if (src->data != NULL) {
+            /* Write all the whole program units straight from the source */
+            num_bytes = size - (size % program_unit);
+
+            err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, src->data, pos,
+                                     num_bytes);
+            src->data += num_bytes;
+        } else {
+            /* Stage as many whole program units as fit in the buffer */
+            num_bytes = ITS_UTILS_MIN(size - (size % program_unit),
+                                      src->buf_size);
+
+            err = src->read_data(src->buf, num_bytes);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+
+            err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, src->buf, pos,
+                                     num_bytes);
+        }
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        pos += num_bytes;
+        size -= num_bytes;
+    }
+
+    return PSA_SUCCESS;
+}
+
 psa_status_t its_flash_fs_dblock_write_file(
                                       struct its_flash_fs_ctx_t *fs_ctx,
                                       const struct its_block_meta_t *block_meta,
                                       const struct its_file_meta_t *file_meta,
                                       size_t offset,
                                       size_t size,
-                                      const uint8_t *data)
+                                      struct its_flash_fs_dblock_src_t *src)
 {
     psa_status_t err;
     uint32_t scratch_id;
     size_t pos;
+    size_t end;
     size_t num_bytes;
 
     scratch_id = its_flash_fs_mblock_cur_data_scratch_id(fs_ctx,
@@ -153,22 +291,43 @@ psa_status_t its_flash_fs_dblock_write_file(
     /* Calculate the position of the new file data in the block */
     pos = file_meta->data_idx + offset;
 
+    /* Calculate the size of the data up to the program unit containing the
+     * new file data position
+     */
+    num_bytes = (pos - (pos % fs_ctx->cfg->program_unit))
+                - block_meta->data_start;
+
     /* Move data up to the new file data position */
     err = its_flash_fs_block_to_block_move(fs_ctx, scratch_id,
                                            block_meta->data_start,
                                            block_meta->phy_id,
                                            block_meta->data_start,
-                                           pos - block_meta->data_start);
+                                           num_bytes);
     if (err != PSA_SUCCESS) {
         return err;
     }
 
     /* Write the new file data */
-    err = fs_ctx->ops->write(fs_ctx->cfg, scratch_id, data, pos, size);
+    err = its_dblock_write_src(fs_ctx, scratch_id, block_meta->phy_id, pos,
+                               size, src);
     if (err != PSA_SUCCESS) {
         return err;
     }
 
+    /* Move the current file data after the new file data, if any */
+    pos = file_meta->data_idx + ITS_UTILS_ALIGN(offset + size,
+                                                fs_ctx->cfg->program_unit);
+    end = file_meta->data_idx + ITS_UTILS_ALIGN(file_meta->cur_size,
+                                                fs_ctx->cfg->program_unit);
+    if (end > pos) {
+        err = its_flash_fs_block_to_block_move(fs_ctx, scratch_id, pos,
+                                               block_meta->phy_id, pos,
+                                               end - pos);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
     /* Calculate the position of the end of the file */
     pos = file_meta->data_idx + file_meta->max_size;
 
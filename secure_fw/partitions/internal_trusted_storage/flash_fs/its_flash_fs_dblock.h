@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -18,27 +18,57 @@
 extern "C" {
 #endif
 
+/*!
+ * \struct its_flash_fs_dblock_src_t
+ *
+ * \brief Source of the data written to a file.
+ */
+struct its_flash_fs_dblock_src_t {
+    const uint8_t *data;                /*!< Data to write, or NULL if the data
+                                         *   is provided by read_data
+                                         */
+    its_flash_fs_read_data_t read_data; /*!< Callback providing the data */
+    uint8_t *buf;                       /*!< Buffer to stage the data provided
+                                         *   by read_data
+                                         */
+    size_t buf_size;                    /*!< Size of buf, a multiple of the
+                                         *   flash program unit
+                                         */
+};
+
 /**
- * \brief Compacts block data for the given logical block.
+ * \brief Moves the data of a file to the scratch data block of the given
+ *        logical block, as part of the compaction of that block.
  *
- * \param[in,out] fs_ctx      Filesystem context
- * \param[in]     lblock      Logical data block to compact
- * \param[in]     free_size   Available data size to compact
- * \param[in]     src_offset  Offset in the current data block which points to
- *                            the data position to reallocate
- * \param[in]     dst_offset  Offset in the scratch block which points to the
- *                            data position to store the data to be reallocated
- * \param[in]     size        Number of bytes to be reallocated
+ * \param[in,out] fs_ctx   Filesystem context
+ * \param[in]     lblock   Logical data block being compacted
+ * \param[in]     src_idx  Offset of the file data in the current data block
+ * \param[in]     dst_idx  Offset of the file data in the scratch data block
+ * \param[in]     size     Number of bytes to move
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_dblock_move_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                           uint32_t lblock,
+                                           size_t src_idx,
+                                           size_t dst_idx,
+                                           size_t size);
+
+/**
+ * \brief Completes the compaction of the given logical block, once the data of
+ *        all the files it contains has been moved to its scratch data block by
+ *        \ref its_flash_fs_dblock_move_file.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     lblock     Logical data block to compact
+ * \param[in]     used_size  Number of bytes used by the files in the block
  *
  * \return Returns error code as specified in \ref psa_status_t
  */
 psa_status_t its_flash_fs_dblock_compact_block(
                                               struct its_flash_fs_ctx_t *fs_ctx,
                                               uint32_t lblock,
-                                              size_t free_size,
-                                              size_t src_offset,
-                                              size_t dst_offset,
-                                              size_t size);
+                                              size_t used_size);
 
 /**
  * \brief Reads the file content.
@@ -58,17 +88,44 @@ psa_status_t its_flash_fs_dblock_read_file(
                                         size_t size,
                                         uint8_t *buf);
 
+/**
+ * \brief Reads the file content in chunks and passes each chunk to a callback.
+ *
+ * \param[in,out] fs_ctx      Filesystem context
+ * \param[in]     file_meta   File metadata
+ * \param[in]     offset      Offset in the file
+ * \param[in]     size        Size to be read
+ * \param[in]     write_data  Callback consuming the data read
+ * \param[in]     buf         Buffer to stage the data
+ * \param[in]     buf_size    Size of the buffer
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t its_flash_fs_dblock_read_file_stream(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        const struct its_file_meta_t *file_meta,
+                                        size_t offset,
+                                        size_t size,
+                                        its_flash_fs_write_data_t write_data,
+                                        uint8_t *buf,
+                                        size_t buf_size);
+
 /**
  * \brief Writes scratch data block content with requested data and the rest of
  *        the data from the given logical block.
  *
+ * \details The incoming data does not need to be aligned with the flash
+ *          program unit. Program units only partly covered by the incoming
+ *          data are completed with the current content of the data block, and
+ *          the current file data after the incoming data is preserved.
+ *
  * \param[in,out] fs_ctx      Filesystem context
  * \param[in]     block_meta  Block metadata
  * \param[in]     file_meta   File metadata
  * \param[in]     offset      Offset in the scratch data block where to start
  *                            the copy of the incoming data
  * \param[in]     size        Size of the incoming data
- * \param[in]     data        Pointer to data buffer to copy in the scratch data
+ * \param[in,out] src         Source of the data to copy in the scratch data
  *                            block
  *
  * \return Returns error code as specified in \ref psa_status_t
@@ -79,7 +136,7 @@ psa_status_t its_flash_fs_dblock_write_file(
                                       const struct its_file_meta_t *file_meta,
                                       size_t offset,
                                       size_t size,
-                                      const uint8_t *data);
+                                      struct its_flash_fs_dblock_src_t *src);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "config_tfm.h"
+#include "its_flash_fs_index.h"
+#include "its_flash_fs_mblock.h"
+
+#if ITS_FILE_INDEX
+
+/**
+ * \brief Gets the home slot of a file ID in the hash table.
+ *
+ * \param[in] fid  File ID
+ *
+ * \return Slot number
+ */
+static uint32_t its_index_home_slot(const uint8_t *fid)
+{
+    /* FNV-1a hash of the file ID */
+    uint32_t hash = 2166136261U;
+    uint32_t i;
+
+    for (i = 0; i < ITS_FILE_ID_SIZE; i++) {
+        hash ^= fid[i];
+        hash *= 16777619U;
+    }
+
+    return hash % ITS_FILE_INDEX_NUM_SLOTS;
+}
+
+void its_flash_fs_index_reset(struct its_flash_fs_index_t *index)
+{
+    (void)memset(index, 0, sizeof(*index));
+}
+
+void its_flash_fs_index_insert(struct its_flash_fs_index_t *index,
+                               uint32_t idx, const uint8_t *fid)
+{
+    uint32_t slot = its_index_home_slot(fid);
+
+    /* There is always an empty slot as the table has more slots than files */
+    while (index->slots[slot] != 0) {
+        slot = (slot + 1) % ITS_FILE_INDEX_NUM_SLOTS;
+    }
+
+    index->slots[slot] = (uint16_t)(idx + 1);
+    (void)memcpy(index->fid[idx], fid, ITS_FILE_ID_SIZE);
+    index->used[idx / 32] |= (1UL << (idx % 32));
+}
+
+void its_flash_fs_index_remove(struct its_flash_fs_index_t *index,
+                               uint32_t idx)
+{
+    uint32_t hole;
+    uint32_t home;
+    uint32_t slot;
+
+    if ((index->used[idx / 32] & (1UL << (idx % 32))) == 0) {
+        return;
+    }
+
+    /* Find the slot holding the entry */
+    hole = its_index_home_slot(index->fid[idx]);
+    while (index->slots[hole] != (uint16_t)(idx + 1)) {
+        hole = (hole + 1) % ITS_FILE_INDEX_NUM_SLOTS;
+    }
+
+    /* Backward shift deletion: move following entries of the probe sequence
+     * into the hole when their home slot allows it, so that lookups never need
+     * tombstones.
+     */
+    slot = hole;
+    for (;;) {
+        slot = (slot + 1) % ITS_FILE_INDEX_NUM_SLOTS;
+        if (index->slots[slot] == 0) {
+            break;
+        }
+
+        home = its_index_home_slot(index->fid[index->slots[slot] - 1]);
+
+        /* Skip the entry if its home slot lies cyclically in (hole, slot] */
+        if ((hole <= slot) ? ((hole < home) && (home <= slot))
+                           : ((hole < home) || (home <= slot))) {
+            continue;
+        }
+
+        index->slots[hole] = index->slots[slot];
+        hole = slot;
+    }
+    index->slots[hole] = 0;
+
+    (void)memset(index->fid[idx], 0, ITS_FILE_ID_SIZE);
+    index->used[idx / 32] &= ~(1UL << (idx % 32));
+}
+
+uint32_t its_flash_fs_index_find(const struct its_flash_fs_index_t *index,
+                                 const uint8_t *fid)
+{
+    uint32_t slot = its_index_home_slot(fid);
+    uint32_t idx;
+
+    while (index->slots[slot] != 0) {
+        idx = index->slots[slot] - 1U;
+        if (memcmp(index->fid[idx], fid, ITS_FILE_ID_SIZE) == 0) {
+            return idx;
+        }
+        slot = (slot + 1) % ITS_FILE_INDEX_NUM_SLOTS;
+    }
+
+    return ITS_METADATA_INVALID_INDEX;
+}
+
+uint32_t its_flash_fs_index_get_free(const struct its_flash_fs_index_t *index,
+                                     uint32_t num_files, bool use_spare)
+{
+    uint32_t i;
+
+    for (i = 0; i < num_files; i++) {
+        /* Skip whole words of used entries */
+        if (((i % 32) == 0) && (index->used[i / 32] == UINT32_MAX)) {
+            i += 31;
+            continue;
+        }
+
+        if ((index->used[i / 32] & (1UL << (i % 32))) == 0) {
+            if (!use_spare) {
+                /* Keep the first free file index as a spare */
+                use_spare = true;
+                continue;
+            }
+            /* Found */
+            return i;
+        }
+    }
+
+    return ITS_METADATA_INVALID_INDEX;
+}
+
+#endif /* ITS_FILE_INDEX */
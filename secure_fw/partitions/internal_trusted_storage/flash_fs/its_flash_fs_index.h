@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/**
+ * \file  its_flash_fs_index.h
+ *
+ * \brief RAM-resident index of the file metadata table stored in the active
+ *        metadata block. It maps file IDs to file metadata entry indexes and
+ *        tracks which entries are in use, so that file lookups and free entry
+ *        searches do not need to read every file metadata entry from flash.
+ */
+
+#ifndef __ITS_FLASH_FS_INDEX_H__
+#define __ITS_FLASH_FS_INDEX_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_tfm.h"
+#include "its_utils.h"
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+#include "ps_object_defs.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ITS_FILE_INDEX
+
+/*!
+ * \def ITS_FILE_INDEX_MAX_FILES
+ *
+ * \brief Maximum number of file metadata entries that can be indexed. It must
+ *        cover the largest filesystem context served by this partition. A
+ *        context with more files than this falls back to flash lookups.
+ */
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+#define ITS_FILE_INDEX_MAX_FILES ITS_UTILS_MAX(ITS_NUM_ASSETS + 1, \
+                                               PS_MAX_NUM_OBJECTS)
+#else
+#define ITS_FILE_INDEX_MAX_FILES (ITS_NUM_ASSETS + 1)
+#endif
+
+/*!
+ * \def ITS_FILE_INDEX_NUM_SLOTS
+ *
+ * \brief Number of hash table slots. Twice the number of indexable files keeps
+ *        the load factor at or below 50% and guarantees an empty slot.
+ */
+#define ITS_FILE_INDEX_NUM_SLOTS (2 * (ITS_FILE_INDEX_MAX_FILES))
+
+/*!
+ * \def ITS_FILE_INDEX_MAX_PENDING
+ *
+ * \brief Maximum number of file metadata entries which can be tracked as
+ *        modified in the scratch metadata block before the whole index needs to
+ *        be rebuilt on the next metadata block swap. A write modifies at most
+ *        two entries (new file and file replaced).
+ */
+#define ITS_FILE_INDEX_MAX_PENDING 2
+
+/*!
+ * \struct its_flash_fs_index_t
+ *
+ * \brief RAM-resident file index for one filesystem context.
+ */
+struct its_flash_fs_index_t {
+    bool valid;            /*!< Index reflects the active metadata block */
+    bool pending_overflow; /*!< Too many scratch entries modified to track */
+    uint8_t num_pending;   /*!< Number of entries in pending[] */
+    uint16_t pending[ITS_FILE_INDEX_MAX_PENDING]; /*!< File metadata entries
+                                                   *   modified in the scratch
+                                                   *   metadata block
+                                                   */
+    uint16_t slots[ITS_FILE_INDEX_NUM_SLOTS]; /*!< Open addressing hash table
+                                               *   of file entry index + 1,
+                                               *   0 means empty
+                                               */
+    uint32_t used[(ITS_FILE_INDEX_MAX_FILES + 31) / 32]; /*!< Bitmap of file
+                                                          *   entries in use
+                                                          */
+    uint8_t fid[ITS_FILE_INDEX_MAX_FILES][ITS_FILE_ID_SIZE]; /*!< File ID of
+                                                              *   each entry
+                                                              */
+};
+
+/**
+ * \brief Empties the index and marks it as invalid.
+ *
+ * \param[out] index  File index
+ */
+void its_flash_fs_index_reset(struct its_flash_fs_index_t *index);
+
+/**
+ * \brief Adds a file metadata entry to the index.
+ *
+ * \param[in,out] index  File index
+ * \param[in]     idx    File metadata entry index
+ * \param[in]     fid    ID of the file stored in the entry
+ */
+void its_flash_fs_index_insert(struct its_flash_fs_index_t *index,
+                               uint32_t idx, const uint8_t *fid);
+
+/**
+ * \brief Removes a file metadata entry from the index, if present.
+ *
+ * \param[in,out] index  File index
+ * \param[in]     idx    File metadata entry index
+ */
+void its_flash_fs_index_remove(struct its_flash_fs_index_t *index,
+                               uint32_t idx);
+
+/**
+ * \brief Finds the file metadata entry index of a file.
+ *
+ * \param[in] index  File index
+ * \param[in] fid    ID of the file
+ *
+ * \return Index of the file metadata entry, or ITS_METADATA_INVALID_INDEX if
+ *         the file does not exist.
+ */
+uint32_t its_flash_fs_index_find(const struct its_flash_fs_index_t *index,
+                                 const uint8_t *fid);
+
+/**
+ * \brief Gets a free file metadata entry index.
+ *
+ * \param[in] index      File index
+ * \param[in] num_files  Number of file metadata entries in the filesystem
+ * \param[in] use_spare  If true then the spare file index will be used,
+ *                       otherwise at least one file index will be left free
+ *
+ * \return Index of a free file metadata entry, or ITS_METADATA_INVALID_INDEX
+ *         if there is none.
+ */
+uint32_t its_flash_fs_index_get_free(const struct its_flash_fs_index_t *index,
+                                     uint32_t num_files, bool use_spare);
+
+#endif /* ITS_FILE_INDEX */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ITS_FLASH_FS_INDEX_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -35,6 +35,20 @@
 #define ITS_BLOCK_METADATA_SIZE     sizeof(struct its_block_meta_t)
 #define ITS_FILE_METADATA_SIZE      sizeof(struct its_file_meta_t)
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+#define ITS_JOURNAL_RECORD_SIZE     sizeof(struct its_journal_record_t)
+
+/* Size of the part of a journal record programmed before its commit */
+#define ITS_JOURNAL_BODY_SIZE       offsetof(struct its_journal_record_t, \
+                                             xor_value)
+
+/* File metadata entry index of an unused entry of a journal record */
+#define ITS_JOURNAL_NO_FILE         0xFFFF
+
+/* Logical block of a journal record which does not update block metadata */
+#define ITS_JOURNAL_NO_BLOCK        0xFFFF
+#endif
+
 /* FIXME: Precompute these for each context */
 /**
  * \brief Gets the physical block ID of the initial position of the scratch
@@ -135,6 +149,40 @@ static size_t its_mblock_file_meta_offset(struct its_flash_fs_ctx_t *fs_ctx,
            + (idx * ITS_FILE_METADATA_SIZE);
 }
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+/**
+ * \brief Gets offset of a metadata journal record in metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     slot    Journal record slot
+ *
+ * \return Return offset value in metadata block
+ */
+static size_t its_mblock_journal_offset(struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t slot)
+{
+    return its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files)
+           + (slot * ITS_JOURNAL_RECORD_SIZE);
+}
+#endif
+
+/**
+ * \brief Gets offset of the data of logical block 0 in metadata block, after
+ *        all the metadata.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Return offset value in metadata block
+ */
+static size_t its_mblock_data_start(struct its_flash_fs_ctx_t *fs_ctx)
+{
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    return its_mblock_journal_offset(fs_ctx, ITS_METADATA_JOURNAL_RECORDS);
+#else
+    return its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files);
+#endif
+}
+
 /**
  * \brief Swaps metablocks. Scratch becomes active and active becomes scratch.
  *
@@ -255,9 +303,7 @@ static psa_status_t its_mblock_validate_file_meta(
 
         if (file_meta->lblock == ITS_LOGICAL_DBLOCK0) {
             /* In block 0, data index must be located after the metadata */
-            if (file_meta->data_idx <
-                its_mblock_file_meta_offset(fs_ctx,
-                                            fs_ctx->cfg->max_num_files)) {
+            if (file_meta->data_idx < its_mblock_data_start(fs_ctx)) {
                 return PSA_ERROR_DATA_CORRUPT;
             }
         }
@@ -312,8 +358,7 @@ static psa_status_t its_mblock_validate_block_meta(
         /* For metadata + data block, data index must start after the
          * metadata area.
          */
-        valid_data_start_value =
-            its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files);
+        valid_data_start_value = its_mblock_data_start(fs_ctx);
     }
 
     if (block_meta->data_start != valid_data_start_value) {
@@ -388,10 +433,12 @@ static psa_status_t its_mblock_calculate_metadata_xor(
                                               uint32_t block_id,
                                               uint8_t *xor_value)
 {
-    uint32_t i, j;
+    size_t i;
     psa_status_t err;
-    uint8_t metadata[ITS_UTILS_MAX(ITS_BLOCK_METADATA_SIZE,
-                                   ITS_FILE_METADATA_SIZE)];
+    size_t pos;
+    size_t end;
+    size_t bytes_to_read;
+    uint8_t metadata[ITS_MAX_BLOCK_DATA_COPY];
     uint8_t xor_value_temp = 0;
 
     if ((block_id != ITS_METADATA_BLOCK0 && block_id != ITS_METADATA_BLOCK1) ||
@@ -399,37 +446,29 @@ static psa_status_t its_mblock_calculate_metadata_xor(
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    /* Calculate the XOR value based on the block metadata. */
-    for (i = 0; i < its_num_active_dblocks(fs_ctx); i++) {
-        err = fs_ctx->ops->read(fs_ctx->cfg, block_id,
-                                metadata,
-                                its_mblock_block_meta_offset(i),
-                                ITS_BLOCK_METADATA_SIZE);
-        if (err != PSA_SUCCESS) {
-            return err;
-        }
+    /* The block metadata and the file metadata are contiguous, so calculate
+     * the XOR value over them with as few reads as possible.
+     */
+    pos = its_mblock_block_meta_offset(ITS_LOGICAL_DBLOCK0);
+    end = its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files);
 
-        /* Update the XOR value. */
-        for (j = 0; j < ITS_BLOCK_METADATA_SIZE; j++) {
-            xor_value_temp ^= metadata[j];
-        }
-    }
+    while (pos < end) {
+        bytes_to_read = ITS_UTILS_MIN(end - pos, sizeof(metadata));
 
-    /* Calculate the XOR value based on the file metadata. */
-    for (i = 0; i < fs_ctx->cfg->max_num_files; i++) {
-        err = fs_ctx->ops->read(fs_ctx->cfg, block_id,
-                                metadata,
-                                its_mblock_file_meta_offset(fs_ctx, i),
-                                ITS_FILE_METADATA_SIZE);
+        err = fs_ctx->ops->read(fs_ctx->cfg, block_id, metadata, pos,
+                                bytes_to_read);
         if (err != PSA_SUCCESS) {
             return err;
         }
 
         /* Update the XOR value. */
-        for (j = 0; j < ITS_FILE_METADATA_SIZE; j++) {
-            xor_value_temp ^= metadata[j];
+        for (i = 0; i < bytes_to_read; i++) {
+            xor_value_temp ^= metadata[i];
         }
+
+        pos += bytes_to_read;
     }
+
     *xor_value = xor_value_temp;
     return PSA_SUCCESS;
 }
@@ -464,6 +503,234 @@ static psa_status_t its_mblock_validate_metadata_xor(
 }
 #endif /* ITS_VALIDATE_METADATA_FROM_FLASH */
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+/**
+ * \brief Gets the position of a file metadata entry in the latest metadata
+ *        journal record which updates it.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     idx     File metadata entry index
+ * \param[in,out] pos     Position of the entry in the active metadata block,
+ *                        left unchanged if no record updates it
+ */
+static void its_mblock_journal_find_file(struct its_flash_fs_ctx_t *fs_ctx,
+                                         uint32_t idx, size_t *pos)
+{
+    struct its_flash_fs_journal_t *journal = &fs_ctx->journal;
+    uint32_t slot = journal->num_records;
+    uint32_t i;
+
+    while (slot-- > 0) {
+        for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+            if (journal->file_idx[slot][i] == idx) {
+                *pos = its_mblock_journal_offset(fs_ctx, slot)
+                       + offsetof(struct its_journal_record_t, file_meta)
+                       + (i * ITS_FILE_METADATA_SIZE);
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Gets the position of a logical block's metadata in the latest
+ *        metadata journal record which updates it.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ * \param[in]     lblock  Logical block number
+ * \param[in,out] pos     Position of the block metadata in the active metadata
+ *                        block, left unchanged if no record updates it
+ */
+static void its_mblock_journal_find_block(struct its_flash_fs_ctx_t *fs_ctx,
+                                          uint32_t lblock, size_t *pos)
+{
+    struct its_flash_fs_journal_t *journal = &fs_ctx->journal;
+    uint32_t slot = journal->num_records;
+
+    while (slot-- > 0) {
+        if (journal->lblock[slot] == lblock) {
+            *pos = its_mblock_journal_offset(fs_ctx, slot)
+                   + offsetof(struct its_journal_record_t, block_meta);
+            return;
+        }
+    }
+}
+#endif /* ITS_METADATA_JOURNAL_RECORDS > 0 */
+
+#if ITS_FILE_INDEX
+/* Number of file metadata entries read at once to build the file index */
+#define ITS_FILE_INDEX_READ_ENTRIES \
+    ITS_UTILS_MAX(ITS_MAX_BLOCK_DATA_COPY / ITS_FILE_METADATA_SIZE, 1)
+
+/**
+ * \brief Builds the RAM file index from the file metadata stored in the active
+ *        metadata block.
+ *
+ * \note If the filesystem has more files than can be indexed, the index is left
+ *       invalid and lookups fall back to reading the metadata from flash.
+ *
+ * \note The file metadata is read in bulk and only its file ID is used. Each
+ *       entry is validated when it is read on access to the file.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_build_file_index(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    psa_status_t err;
+    uint32_t i;
+    uint32_t j;
+    uint32_t num_entries;
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    size_t pos;
+#endif
+    struct its_file_meta_t tmp_metadata[ITS_FILE_INDEX_READ_ENTRIES];
+
+    its_flash_fs_index_reset(&fs_ctx->file_index);
+
+    if (fs_ctx->cfg->max_num_files > ITS_FILE_INDEX_MAX_FILES) {
+        return PSA_SUCCESS;
+    }
+
+    for (i = 0; i < fs_ctx->cfg->max_num_files; i += num_entries) {
+        num_entries = ITS_UTILS_MIN(fs_ctx->cfg->max_num_files - i,
+                                    ITS_FILE_INDEX_READ_ENTRIES);
+
+        err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
+                                (uint8_t *)tmp_metadata,
+                                its_mblock_file_meta_offset(fs_ctx, i),
+                                num_entries * ITS_FILE_METADATA_SIZE);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        for (j = 0; j < num_entries; j++) {
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+            /* Take the entries updated by the journal from their record */
+            pos = its_mblock_file_meta_offset(fs_ctx, i + j);
+            its_mblock_journal_find_file(fs_ctx, i + j, &pos);
+            if (pos != its_mblock_file_meta_offset(fs_ctx, i + j)) {
+                err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
+                                        (uint8_t *)&tmp_metadata[j], pos,
+                                        ITS_FILE_METADATA_SIZE);
+                if (err != PSA_SUCCESS) {
+                    return err;
+                }
+            }
+#endif
+
+            if (its_utils_validate_fid(tmp_metadata[j].id) == PSA_SUCCESS) {
+                its_flash_fs_index_insert(&fs_ctx->file_index, i + j,
+                                          tmp_metadata[j].id);
+            }
+        }
+    }
+
+    fs_ctx->file_index.valid = true;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Records that the file ID of a file metadata entry has been modified in
+ *        the scratch metadata block, so that the index can be updated when the
+ *        scratch metadata block becomes active.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     idx        File metadata entry index
+ * \param[in]     file_meta  File metadata written to the scratch metadata block
+ */
+static void its_mblock_file_index_mark_pending(
+                                        struct its_flash_fs_ctx_t *fs_ctx,
+                                        uint32_t idx,
+                                        const struct its_file_meta_t *file_meta)
+{
+    struct its_flash_fs_index_t *index = &fs_ctx->file_index;
+    static const uint8_t empty_fid[ITS_FILE_ID_SIZE] = {0};
+    const uint8_t *cur_fid;
+    uint32_t i;
+
+    if (!index->valid || index->pending_overflow) {
+        return;
+    }
+
+    /* Entries whose file ID is unchanged, e.g. files moved by a compaction,
+     * do not affect the index.
+     */
+    if (index->used[idx / 32] & (1UL << (idx % 32))) {
+        cur_fid = index->fid[idx];
+    } else {
+        cur_fid = empty_fid;
+    }
+    if ((its_utils_validate_fid(file_meta->id) != PSA_SUCCESS) ?
+        (cur_fid == empty_fid) :
+        (memcmp(cur_fid, file_meta->id, ITS_FILE_ID_SIZE) == 0)) {
+        return;
+    }
+
+    for (i = 0; i < index->num_pending; i++) {
+        if (index->pending[i] == idx) {
+            return;
+        }
+    }
+
+    if (index->num_pending < ITS_FILE_INDEX_MAX_PENDING) {
+        index->pending[index->num_pending++] = (uint16_t)idx;
+    } else {
+        index->pending_overflow = true;
+    }
+}
+
+/**
+ * \brief Updates the index with the file metadata entries recorded as pending,
+ *        after the scratch metadata block has become the active one.
+ *
+ * \note Entries are re-read from the new active metadata block, so an entry
+ *       recorded by an update which did not complete only costs an extra read.
+ *       If the index cannot be updated, it is rebuilt or, on failure,
+ *       invalidated so that lookups fall back to reading the metadata from
+ *       flash.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_mblock_file_index_commit_pending(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_flash_fs_index_t *index = &fs_ctx->file_index;
+    struct its_file_meta_t tmp_metadata;
+    uint32_t i;
+
+    if (!index->valid) {
+        return;
+    }
+
+    if (index->pending_overflow) {
+        if (its_mblock_build_file_index(fs_ctx) != PSA_SUCCESS) {
+            its_flash_fs_index_reset(index);
+        }
+        return;
+    }
+
+    for (i = 0; i < index->num_pending; i++) {
+        if (its_flash_fs_mblock_read_file_meta(fs_ctx, index->pending[i],
+                                               &tmp_metadata) != PSA_SUCCESS) {
+            its_flash_fs_index_reset(index);
+            return;
+        }
+
+        its_flash_fs_index_remove(index, index->pending[i]);
+        if (its_utils_validate_fid(tmp_metadata.id) == PSA_SUCCESS) {
+            its_flash_fs_index_insert(index, index->pending[i],
+                                      tmp_metadata.id);
+        }
+    }
+
+    index->num_pending = 0;
+}
+#endif /* ITS_FILE_INDEX */
+
 /**
  * \brief Gets a free file metadata table entry.
  *
@@ -480,6 +747,14 @@ static uint32_t its_get_free_file_index(struct its_flash_fs_ctx_t *fs_ctx,
     uint32_t i;
     struct its_file_meta_t tmp_metadata;
 
+#if ITS_FILE_INDEX
+    if (fs_ctx->file_index.valid) {
+        return its_flash_fs_index_get_free(&fs_ctx->file_index,
+                                           fs_ctx->cfg->max_num_files,
+                                           use_spare);
+    }
+#endif
+
     for (i = 0; i < fs_ctx->cfg->max_num_files; i++) {
         err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
         if (err != PSA_SUCCESS) {
@@ -505,6 +780,100 @@ static uint32_t its_get_free_file_index(struct its_flash_fs_ctx_t *fs_ctx,
     return ITS_METADATA_INVALID_INDEX;
 }
 
+/**
+ * \brief Copies the file metadata entries between two indexes from the active
+ *        metadata block to the scratch metadata block.
+ *
+ * \param[in,out] fs_ctx     Filesystem context
+ * \param[in]     idx_start  File metadata entry index to start copy, inclusive
+ * \param[in]     idx_end    File metadata entry index to end copy, exclusive
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_copy_file_meta(struct its_flash_fs_ctx_t *fs_ctx,
+                                              uint32_t idx_start,
+                                              uint32_t idx_end)
+{
+    /* Calculate the positions of the two indexes in the metadata block */
+    size_t pos_start = its_mblock_file_meta_offset(fs_ctx, idx_start);
+    size_t pos_end = its_mblock_file_meta_offset(fs_ctx, idx_end);
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    psa_status_t err;
+    size_t src_pos;
+
+    /* Entries updated by journal records are copied from the latest one */
+    if (fs_ctx->journal.num_records != 0) {
+        for (; pos_start < pos_end; pos_start += ITS_FILE_METADATA_SIZE) {
+            src_pos = pos_start;
+            its_mblock_journal_find_file(fs_ctx, idx_start++, &src_pos);
+            err = its_flash_fs_block_to_block_move(fs_ctx,
+                                                   fs_ctx->scratch_metablock,
+                                                   pos_start,
+                                                   fs_ctx->active_metablock,
+                                                   src_pos,
+                                                   ITS_FILE_METADATA_SIZE);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+        return PSA_SUCCESS;
+    }
+#endif
+
+    /* Copy all data between the two positions from the active metadata block
+     * to the scratch metadata block.
+     */
+    return its_flash_fs_block_to_block_move(fs_ctx, fs_ctx->scratch_metablock,
+                                            pos_start, fs_ctx->active_metablock,
+                                            pos_start, pos_end - pos_start);
+}
+
+/**
+ * \brief Copies the block metadata between two logical blocks from the active
+ *        metadata block to the scratch metadata block.
+ *
+ * \param[in,out] fs_ctx        Filesystem context
+ * \param[in]     lblock_start  Logical block to start copy, inclusive
+ * \param[in]     lblock_end    Logical block to end copy, exclusive
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_copy_block_meta(struct its_flash_fs_ctx_t *fs_ctx,
+                                               uint32_t lblock_start,
+                                               uint32_t lblock_end)
+{
+    size_t pos_start = its_mblock_block_meta_offset(lblock_start);
+    size_t pos_end = its_mblock_block_meta_offset(lblock_end);
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    psa_status_t err;
+    size_t src_pos;
+
+    /* Block metadata updated by journal records is copied from the latest
+     * one.
+     */
+    if (fs_ctx->journal.num_records != 0) {
+        for (; pos_start < pos_end; pos_start += ITS_BLOCK_METADATA_SIZE) {
+            src_pos = pos_start;
+            its_mblock_journal_find_block(fs_ctx, lblock_start++, &src_pos);
+            err = its_flash_fs_block_to_block_move(fs_ctx,
+                                                   fs_ctx->scratch_metablock,
+                                                   pos_start,
+                                                   fs_ctx->active_metablock,
+                                                   src_pos,
+                                                   ITS_BLOCK_METADATA_SIZE);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+        return PSA_SUCCESS;
+    }
+#endif
+
+    return its_flash_fs_block_to_block_move(fs_ctx, fs_ctx->scratch_metablock,
+                                            pos_start, fs_ctx->active_metablock,
+                                            pos_start, pos_end - pos_start);
+}
+
 /**
  * \brief Erases data and meta scratch blocks.
  *
@@ -580,13 +949,9 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
 {
     struct its_block_meta_t block_meta;
     psa_status_t err;
-    uint32_t meta_block;
-    size_t pos;
     uint32_t scratch_block;
-    size_t size;
 
     scratch_block = fs_ctx->scratch_metablock;
-    meta_block = fs_ctx->active_metablock;
 
     if (lblock != ITS_LOGICAL_DBLOCK0) {
         /* The file data in the logical block 0 is stored in same physical
@@ -618,14 +983,10 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
          * the logical block provided in the function.
          */
         if (lblock > 1) {
-            pos = its_mblock_block_meta_offset(ITS_LOGICAL_DBLOCK0 + 1);
-
-            size = its_mblock_block_meta_offset(lblock) - pos;
-
             /* Copy rest of the block data from previous block */
             /* Data before updated content */
-            err = its_flash_fs_block_to_block_move(fs_ctx, scratch_block, pos,
-                                                   meta_block, pos, size);
+            err = its_mblock_copy_block_meta(fs_ctx, ITS_LOGICAL_DBLOCK0 + 1,
+                                             lblock);
             if (err != PSA_SUCCESS) {
                 return err;
             }
@@ -633,13 +994,342 @@ static psa_status_t its_mblock_copy_remaining_block_meta(
     }
 
     /* Move meta blocks data after updated content */
-    pos = its_mblock_block_meta_offset(lblock+1);
+    return its_mblock_copy_block_meta(fs_ctx, lblock + 1,
+                                      its_num_active_dblocks(fs_ctx));
+}
+
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+/**
+ * \brief Calculates the XOR value of a metadata journal record.
+ *
+ * \param[in] record  Metadata journal record
+ *
+ * \return Returns the XOR value of the record members before the XOR value
+ */
+static uint8_t its_mblock_journal_record_xor(
+                                    const struct its_journal_record_t *record)
+{
+    const uint8_t *p_record = (const uint8_t *)record;
+    uint8_t xor_value = 0;
+    size_t i;
+
+    for (i = 0; i < offsetof(struct its_journal_record_t, xor_value); i++) {
+        xor_value ^= p_record[i];
+    }
+
+    return xor_value;
+}
+
+/**
+ * \brief Starts a new update, which is held in RAM until it is journaled or
+ *        modifies more metadata entries than a journal record can hold.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_mblock_journal_reset_update(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_journal_record_t *update = &fs_ctx->journal.update;
+    uint32_t i;
+
+    (void)memset(update, 0, ITS_JOURNAL_RECORD_SIZE);
+    for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+        update->file_idx[i] = ITS_JOURNAL_NO_FILE;
+    }
+    update->lblock = ITS_JOURNAL_NO_BLOCK;
+
+    /* Keep the current scratch data block, to know whether the update swaps
+     * it.
+     */
+    update->scratch_dblock = fs_ctx->meta_block_header.scratch_dblock;
+
+    fs_ctx->journal.direct = false;
+}
+
+/**
+ * \brief Empties the metadata journal after the metadata blocks are swapped.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+static void its_mblock_journal_clear(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    fs_ctx->journal.num_records = 0;
+    fs_ctx->journal.torn = false;
+
+    its_mblock_journal_reset_update(fs_ctx);
+}
+
+/**
+ * \brief Writes the metadata entries of the current update held in RAM to the
+ *        scratch metadata block. The rest of the update is written directly to
+ *        the scratch metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_write_update(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_journal_record_t *update = &fs_ctx->journal.update;
+    psa_status_t err;
+    uint32_t i;
+
+    fs_ctx->journal.direct = true;
+
+    for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+        if (update->file_idx[i] != ITS_JOURNAL_NO_FILE) {
+            err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->scratch_metablock,
+                                     (const uint8_t *)&update->file_meta[i],
+                                     its_mblock_file_meta_offset(fs_ctx,
+                                                         update->file_idx[i]),
+                                     ITS_FILE_METADATA_SIZE);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+    }
+
+    if (update->lblock != ITS_JOURNAL_NO_BLOCK) {
+        return its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
+                                                             update->lblock,
+                                                           &update->block_meta);
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Appends the current update to the metadata journal of the active
+ *        metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_append(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_flash_fs_journal_t *journal = &fs_ctx->journal;
+    struct its_journal_record_t *update = &journal->update;
+    uint32_t prev_scratch_dblock = update->scratch_dblock;
+    uint32_t slot = journal->num_records;
+    psa_status_t err;
+    uint32_t i;
+
+    update->scratch_dblock = fs_ctx->meta_block_header.scratch_dblock;
+    update->xor_value = its_mblock_journal_record_xor(update);
+    update->commit = (uint8_t)~fs_ctx->cfg->erase_val;
+
+    /* Program the record in the erased slot of the active metadata block */
+    err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (const uint8_t *)update,
+                             its_mblock_journal_offset(fs_ctx, slot),
+                             ITS_JOURNAL_BODY_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->ops->flush(fs_ctx->cfg, fs_ctx->active_metablock);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Then commit it by programming the last program unit of the record,
+     * which holds the XOR value and the commit.
+     */
+    err = fs_ctx->ops->write(fs_ctx->cfg, fs_ctx->active_metablock,
+                             (const uint8_t *)update + ITS_JOURNAL_BODY_SIZE,
+                             its_mblock_journal_offset(fs_ctx, slot)
+                             + ITS_JOURNAL_BODY_SIZE,
+                             ITS_JOURNAL_RECORD_SIZE - ITS_JOURNAL_BODY_SIZE);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    err = fs_ctx->ops->flush(fs_ctx->cfg, fs_ctx->active_metablock);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+        journal->file_idx[slot][i] = update->file_idx[i];
+    }
+    journal->lblock[slot] = update->lblock;
+    journal->num_records++;
+
+#if ITS_FILE_INDEX
+    /* Bring the file index in line with the journaled metadata */
+    its_mblock_file_index_commit_pending(fs_ctx);
+#endif
+
+    /* Erase the data block replaced by the update, which is now the scratch
+     * data block.
+     */
+    if (update->scratch_dblock != prev_scratch_dblock) {
+        err = fs_ctx->ops->erase(fs_ctx->cfg, update->scratch_dblock);
+    }
+
+    its_mblock_journal_reset_update(fs_ctx);
+
+    return err;
+}
+
+/**
+ * \brief Writes the complete metadata to the scratch metadata block, from the
+ *        current update, the metadata journal and the active metadata block,
+ *        so that the metadata blocks can be swapped.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_consolidate(
+                                              struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_journal_record_t *update = &fs_ctx->journal.update;
+    struct its_block_meta_t block_meta;
+    psa_status_t err;
+    uint32_t idx;
+    uint32_t i;
+
+    err = its_mblock_journal_write_update(fs_ctx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Logical block 0 moves to the scratch metadata block, which also copies
+     * the rest of the block metadata.
+     */
+    if (update->lblock == ITS_JOURNAL_NO_BLOCK) {
+        err = its_flash_fs_mblock_read_block_metadata(fs_ctx,
+                                                      ITS_LOGICAL_DBLOCK0,
+                                                      &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        err = its_flash_fs_mblock_update_scratch_block_meta(fs_ctx,
+                                                           ITS_LOGICAL_DBLOCK0,
+                                                           &block_meta);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+
+    /* Copy the file metadata entries not modified by the update */
+    for (idx = 0; idx < fs_ctx->cfg->max_num_files; idx++) {
+        for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+            if (update->file_idx[i] == idx) {
+                break;
+            }
+        }
+
+        if (i == ITS_JOURNAL_MAX_FILES) {
+            err = its_mblock_copy_file_meta(fs_ctx, idx, idx + 1);
+            if (err != PSA_SUCCESS) {
+                return err;
+            }
+        }
+    }
+
+    return its_flash_fs_mblock_migrate_lb0_data_to_scratch(fs_ctx);
+}
+
+/**
+ * \brief Checks whether a metadata journal record slot is still erased.
+ *
+ * \param[in] fs_ctx  Filesystem context
+ * \param[in] record  Metadata journal record read from the slot
+ *
+ * \return Returns true if the slot is erased, false otherwise
+ */
+static bool its_mblock_journal_slot_erased(struct its_flash_fs_ctx_t *fs_ctx,
+                                     const struct its_journal_record_t *record)
+{
+    const uint8_t *p_record = (const uint8_t *)record;
+    size_t i;
+
+    for (i = 0; i < ITS_JOURNAL_RECORD_SIZE; i++) {
+        if (p_record[i] != fs_ctx->cfg->erase_val) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Loads the metadata journal of the active metadata block.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t its_mblock_journal_load(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    struct its_flash_fs_journal_t *journal = &fs_ctx->journal;
+    struct its_journal_record_t *record = &journal->update;
+    struct its_block_meta_t block_meta;
+    uint8_t commit = (uint8_t)~fs_ctx->cfg->erase_val;
+    psa_status_t err;
+    uint32_t slot;
+    uint32_t i;
+
+    journal->num_records = 0;
+    journal->torn = false;
+
+    /* The journal is part of the metadata block layout, which a filesystem
+     * created with another layout does not have.
+     */
+    if (fs_ctx->meta_block_header.fs_version != ITS_SUPPORTED_VERSION) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    err = its_flash_fs_mblock_read_block_metadata(fs_ctx, ITS_LOGICAL_DBLOCK0,
+                                                  &block_meta);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    if (block_meta.data_start != its_mblock_data_start(fs_ctx)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    for (slot = 0; slot < ITS_METADATA_JOURNAL_RECORDS; slot++) {
+        err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
+                                (uint8_t *)record,
+                                its_mblock_journal_offset(fs_ctx, slot),
+                                ITS_JOURNAL_RECORD_SIZE);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        if ((record->commit != commit) ||
+            (record->xor_value != its_mblock_journal_record_xor(record)) ||
+            (record->scratch_dblock >= fs_ctx->cfg->num_blocks)) {
+            /* A record interrupted by a power failure is ignored, but its slot
+             * can no longer be programmed.
+             */
+            journal->torn = !its_mblock_journal_slot_erased(fs_ctx, record);
+            break;
+        }
+
+        for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+            journal->file_idx[slot][i] = record->file_idx[i];
+        }
+        journal->lblock[slot] = record->lblock;
+        journal->num_records++;
+
+        /* The metadata block header is only rewritten when the metadata
+         * blocks are swapped.
+         */
+        fs_ctx->meta_block_header.scratch_dblock = record->scratch_dblock;
+    }
 
-    size = its_mblock_file_meta_offset(fs_ctx, 0) - pos;
+    its_mblock_journal_reset_update(fs_ctx);
 
-    return its_flash_fs_block_to_block_move(fs_ctx, scratch_block, pos,
-                                            meta_block, pos, size);
+    return PSA_SUCCESS;
 }
+#endif /* ITS_METADATA_JOURNAL_RECORDS > 0 */
 
 /**
  * \brief Checks the validity of the metadata block's swap count.
@@ -837,29 +1527,6 @@ static psa_status_t its_mblock_upgrade_meta_header(
     return its_flash_fs_mblock_meta_update_finalize(fs_ctx);
 }
 
-/**
- * \brief Reads the active metadata block header into its_system_ctx.
- *
- * \param[in,out] fs_ctx  Filesystem context
- *
- * \return Returns error code as specified in \ref psa_status_t
- */
-static psa_status_t its_mblock_read_meta_header(
-                                              struct its_flash_fs_ctx_t *fs_ctx)
-{
-    psa_status_t err;
-
-    err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
-                            (uint8_t *)&fs_ctx->meta_block_header, 0,
-                            ITS_BLOCK_META_HEADER_SIZE);
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
-
-    return its_mblock_validate_header_meta(fs_ctx, &fs_ctx->meta_block_header,
-                                           fs_ctx->active_metablock);
-}
-
 /**
  * \brief Reserves space for an file.
  *
@@ -908,7 +1575,8 @@ static psa_status_t its_mblock_reserve_file(struct its_flash_fs_ctx_t *fs_ctx,
 }
 
 /**
- * \brief Validates and find the valid-active metablock
+ * \brief Validates and find the valid-active metablock, and reads its header
+ *        into the filesystem context.
  *
  * \param[in,out] fs_ctx  Filesystem context
  *
@@ -963,6 +1631,10 @@ static psa_status_t its_init_get_active_metablock(
     fs_ctx->active_metablock = cur_meta_block;
     fs_ctx->scratch_metablock = ITS_OTHER_META_BLOCK(cur_meta_block);
 
+    /* The header has already been validated, so it is not read again */
+    fs_ctx->meta_block_header = (cur_meta_block == ITS_METADATA_BLOCK0) ?
+                                h_meta0 : h_meta1;
+
     return PSA_SUCCESS;
 }
 
@@ -970,16 +1642,14 @@ psa_status_t its_flash_fs_mblock_cp_file_meta(struct its_flash_fs_ctx_t *fs_ctx,
                                               uint32_t idx_start,
                                               uint32_t idx_end)
 {
-    /* Calculate the positions of the two indexes in the metadata block */
-    size_t pos_start = its_mblock_file_meta_offset(fs_ctx, idx_start);
-    size_t pos_end = its_mblock_file_meta_offset(fs_ctx, idx_end);
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    /* A journaled update leaves the scratch metadata block untouched */
+    if (!fs_ctx->journal.direct) {
+        return PSA_SUCCESS;
+    }
+#endif
 
-    /* Copy all data between the two positions from the scratch metadata block
-     * to the active metadata block.
-     */
-    return its_flash_fs_block_to_block_move(fs_ctx, fs_ctx->scratch_metablock,
-                                            pos_start, fs_ctx->active_metablock,
-                                            pos_start, pos_end - pos_start);
+    return its_mblock_copy_file_meta(fs_ctx, idx_start, idx_end);
 }
 
 uint32_t its_flash_fs_mblock_cur_data_scratch_id(
@@ -1003,6 +1673,29 @@ psa_status_t its_flash_fs_mblock_get_file_idx_meta(struct its_flash_fs_ctx_t *fs
     uint32_t i;
     struct its_file_meta_t tmp_metadata;
 
+#if ITS_FILE_INDEX
+    if (fs_ctx->file_index.valid) {
+        i = its_flash_fs_index_find(&fs_ctx->file_index, fid);
+        if (i == ITS_METADATA_INVALID_INDEX) {
+            return PSA_ERROR_DOES_NOT_EXIST;
+        }
+
+        *idx = i;
+        if (file_meta != NULL) {
+            err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, file_meta);
+            if (err != PSA_SUCCESS) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+
+            /* The index must be coherent with the active metadata block */
+            if (memcmp(file_meta->id, fid, ITS_FILE_ID_SIZE)) {
+                return PSA_ERROR_GENERIC_ERROR;
+            }
+        }
+        return PSA_SUCCESS;
+    }
+#endif
+
     for (i = 0; i < fs_ctx->cfg->max_num_files; i++) {
         err = its_flash_fs_mblock_read_file_meta(fs_ctx, i, &tmp_metadata);
         if (err != PSA_SUCCESS) {
@@ -1058,15 +1751,21 @@ psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx)
         return err;
     }
 
+    /* Find the active metadata block and load its validated header */
     err = its_init_get_active_metablock(fs_ctx);
     if (err != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
 
-    err = its_mblock_read_meta_header(fs_ctx);
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    /* Apply the journal of the active metadata block, which may change the
+     * scratch data block to erase.
+     */
+    err = its_mblock_journal_load(fs_ctx);
     if (err != PSA_SUCCESS) {
         return PSA_ERROR_GENERIC_ERROR;
     }
+#endif
 
     /* Erase the other scratch metadata block. It can be used in the later
      * step.
@@ -1077,14 +1776,47 @@ psa_status_t its_flash_fs_mblock_init(struct its_flash_fs_ctx_t *fs_ctx)
     }
 
     /* Upgrade the metadata header if required. */
-    return its_mblock_upgrade_meta_header(fs_ctx);
+    err = its_mblock_upgrade_meta_header(fs_ctx);
+#if ITS_FILE_INDEX
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Build the RAM file index from the active metadata block */
+    err = its_mblock_build_file_index(fs_ctx);
+#endif
+
+    return err;
 }
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+void its_flash_fs_mblock_meta_update_start(struct its_flash_fs_ctx_t *fs_ctx)
+{
+    its_mblock_journal_reset_update(fs_ctx);
+}
+#endif
+
 psa_status_t its_flash_fs_mblock_meta_update_finalize(
                                               struct its_flash_fs_ctx_t *fs_ctx)
 {
     psa_status_t err;
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    if (!fs_ctx->journal.direct) {
+        /* Append the update to the journal while it has a free slot */
+        if (!fs_ctx->journal.torn &&
+            (fs_ctx->journal.num_records < ITS_METADATA_JOURNAL_RECORDS)) {
+            return its_mblock_journal_append(fs_ctx);
+        }
+
+        /* Otherwise consolidate the journal into the scratch metadata block */
+        err = its_mblock_journal_consolidate(fs_ctx);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+#endif
+
     /* Write the metadata block header to flash */
     err = its_mblock_write_scratch_meta_header(fs_ctx);
     if (err != PSA_SUCCESS) {
@@ -1100,6 +1832,16 @@ psa_status_t its_flash_fs_mblock_meta_update_finalize(
     /* Update the running context */
     its_mblock_swap_metablocks(fs_ctx);
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    /* The new active metadata block has an empty journal */
+    its_mblock_journal_clear(fs_ctx);
+#endif
+
+#if ITS_FILE_INDEX
+    /* Bring the file index in line with the new active metadata block */
+    its_mblock_file_index_commit_pending(fs_ctx);
+#endif
+
     /* Erase meta block and current scratch block */
     return its_mblock_erase_scratch_blocks(fs_ctx);
 }
@@ -1111,6 +1853,13 @@ psa_status_t its_flash_fs_mblock_migrate_lb0_data_to_scratch(
     size_t data_size;
     psa_status_t err;
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    /* A journaled update leaves the data of logical block 0 in place */
+    if (!fs_ctx->journal.direct) {
+        return PSA_SUCCESS;
+    }
+#endif
+
     err = its_flash_fs_mblock_read_block_metadata(fs_ctx, ITS_LOGICAL_DBLOCK0,
                                                   &block_meta);
     if (err != PSA_SUCCESS) {
@@ -1136,6 +1885,9 @@ psa_status_t its_flash_fs_mblock_read_file_meta(
     size_t offset;
 
     offset = its_mblock_file_meta_offset(fs_ctx, idx);
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    its_mblock_journal_find_file(fs_ctx, idx, &offset);
+#endif
     err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
                             (uint8_t *)file_meta, offset,
                             ITS_FILE_METADATA_SIZE);
@@ -1158,6 +1910,9 @@ psa_status_t its_flash_fs_mblock_read_block_metadata(
     size_t pos;
 
     pos = its_mblock_block_meta_offset(lblock);
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    its_mblock_journal_find_block(fs_ctx, lblock, &pos);
+#endif
     err = fs_ctx->ops->read(fs_ctx->cfg, fs_ctx->active_metablock,
                             (uint8_t *)block_meta, pos,
                             ITS_BLOCK_METADATA_SIZE);
@@ -1228,6 +1983,16 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
     uint32_t metablock_to_erase_first = ITS_METADATA_BLOCK0;
     struct its_file_meta_t file_metadata;
 
+#if ITS_FILE_INDEX
+    /* The index is rebuilt when the filesystem is prepared again */
+    its_flash_fs_index_reset(&fs_ctx->file_index);
+#endif
+
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    /* The new metadata is written directly to the scratch metadata block */
+    fs_ctx->journal.direct = true;
+#endif
+
     /* Erase both metadata blocks. If at least one metadata block is valid,
      * ensure that the active metadata block is erased last to prevent rollback
      * in the case of a power failure between the two erases.
@@ -1260,8 +2025,7 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
      * datablock, the space available for data is from the end of the metadata
      * to the end of the block.
      */
-    block_meta.data_start =
-        its_mblock_file_meta_offset(fs_ctx, fs_ctx->cfg->max_num_files);
+    block_meta.data_start = its_mblock_data_start(fs_ctx);
     block_meta.free_size = fs_ctx->cfg->block_size - block_meta.data_start;
     block_meta.phy_id = fs_ctx->scratch_metablock;
     err = its_mblock_update_scratch_block_meta(fs_ctx, ITS_LOGICAL_DBLOCK0,
@@ -1327,6 +2091,10 @@ psa_status_t its_flash_fs_mblock_reset_metablock(
     /* Swap active and scratch metablocks */
     its_mblock_swap_metablocks(fs_ctx);
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    its_mblock_journal_clear(fs_ctx);
+#endif
+
     return PSA_SUCCESS;
 }
 
@@ -1345,6 +2113,27 @@ psa_status_t its_flash_fs_mblock_update_scratch_block_meta(
 {
     psa_status_t err;
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    struct its_flash_fs_journal_t *journal = &fs_ctx->journal;
+
+    if (!journal->direct) {
+        /* The data of logical block 0 is in the metadata block, so an update
+         * of it requires the metadata blocks to be swapped.
+         */
+        if ((lblock != ITS_LOGICAL_DBLOCK0) &&
+            (journal->update.lblock == ITS_JOURNAL_NO_BLOCK)) {
+            journal->update.lblock = (uint16_t)lblock;
+            journal->update.block_meta = *block_meta;
+            return PSA_SUCCESS;
+        }
+
+        err = its_mblock_journal_write_update(fs_ctx);
+        if (err != PSA_SUCCESS) {
+            return PSA_ERROR_GENERIC_ERROR;
+        }
+    }
+#endif
+
     /* If the file is the logical block 0, then update the physical ID to the
      * current scratch metadata block so that it is correct after the metadata
      * blocks are swapped.
@@ -1367,6 +2156,37 @@ psa_status_t its_flash_fs_mblock_update_scratch_file_meta(
                                         const struct its_file_meta_t *file_meta)
 {
     size_t pos;
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    struct its_journal_record_t *update = &fs_ctx->journal.update;
+    psa_status_t err;
+    uint32_t i;
+#endif
+
+#if ITS_FILE_INDEX
+    its_mblock_file_index_mark_pending(fs_ctx, idx, file_meta);
+#endif
+
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    if (!fs_ctx->journal.direct) {
+        /* Hold the entry in the record of the update, in a free slot or in
+         * the slot of a previous write of the same entry.
+         */
+        for (i = 0; i < ITS_JOURNAL_MAX_FILES; i++) {
+            if ((update->file_idx[i] == ITS_JOURNAL_NO_FILE) ||
+                (update->file_idx[i] == idx)) {
+                update->file_idx[i] = (uint16_t)idx;
+                update->file_meta[i] = *file_meta;
+                return PSA_SUCCESS;
+            }
+        }
+
+        /* The update modifies too many entries to be journaled */
+        err = its_mblock_journal_write_update(fs_ctx);
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+    }
+#endif
 
     /* Calculate the position */
     pos = its_mblock_file_meta_offset(fs_ctx, idx);
@@ -1386,6 +2206,12 @@ psa_status_t its_flash_fs_block_to_block_move(struct its_flash_fs_ctx_t *fs_ctx,
     size_t bytes_to_move;
     uint8_t dst_block_data_copy[ITS_MAX_BLOCK_DATA_COPY];
 
+    /* Let the flash implementation copy the data in one operation if it can */
+    if (fs_ctx->ops->copy != NULL) {
+        return fs_ctx->ops->copy(fs_ctx->cfg, dst_block, dst_offset, src_block,
+                                 src_offset, size);
+    }
+
     while (size > 0) {
         /* Calculates the number of bytes to move */
         bytes_to_move = ITS_UTILS_MIN(size, ITS_MAX_BLOCK_DATA_COPY);
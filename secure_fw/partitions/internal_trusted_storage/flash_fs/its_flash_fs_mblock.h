@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -14,6 +14,7 @@
 
 #include "flash/its_flash.h"
 #include "its_flash_fs.h"
+#include "its_flash_fs_index.h"
 #include "its_utils.h"
 #include "psa/error.h"
 
@@ -179,6 +180,84 @@ struct its_file_meta_t {
 };
 #undef _T3
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+/*!
+ * \def ITS_JOURNAL_MAX_FILES
+ *
+ * \brief Defines the maximum number of file metadata entries updated by a
+ *        metadata journal record.
+ */
+#define ITS_JOURNAL_MAX_FILES  2
+
+/*!
+ * \struct its_journal_record_t
+ *
+ * \brief Structure to store a metadata journal record, which holds the
+ *        metadata entries modified by one update of the filesystem.
+ *
+ * \note The record is programmed in two writes: the members before the XOR
+ *       value first, then the program unit holding the XOR value and the
+ *       commit. The XOR value is aligned to the maximum required flash
+ *       program unit, so that the commit is never programmed together with
+ *       the rest of the record.
+ *
+ * \note This structure is programmed to flash, so its size must be padded
+ *       to a multiple of the maximum required flash program unit.
+ */
+struct its_journal_record_t {
+    struct its_file_meta_t file_meta[ITS_JOURNAL_MAX_FILES]; /*!< Updated file
+                                                              *   metadata
+                                                              */
+    struct its_block_meta_t block_meta; /*!< Updated block metadata */
+    uint32_t scratch_dblock;  /*!< Physical block ID of the data section's
+                               *   scratch block after the update
+                               */
+    uint16_t file_idx[ITS_JOURNAL_MAX_FILES]; /*!< File metadata entry
+                                               *   indexes, or
+                                               *   ITS_JOURNAL_NO_FILE
+                                               */
+    uint16_t lblock;          /*!< Logical block of the block metadata, or
+                               *   ITS_JOURNAL_NO_BLOCK
+                               */
+    uint8_t xor_value __attribute__((__aligned__(ITS_FLASH_MAX_ALIGNMENT)));
+                              /*!< XOR value of the members above */
+    uint8_t commit;           /*!< Programmed last to commit the record */
+};
+
+/*!
+ * \def ITS_METADATA_JOURNAL_SIZE
+ *
+ * \brief Defines the size of the metadata journal area, located in the
+ *        metadata block between the file metadata and the data of logical
+ *        block 0.
+ */
+#define ITS_METADATA_JOURNAL_SIZE \
+    (ITS_METADATA_JOURNAL_RECORDS * sizeof(struct its_journal_record_t))
+
+/**
+ * \struct its_flash_fs_journal_t
+ *
+ * \brief Structure to store the state of the metadata journal.
+ */
+struct its_flash_fs_journal_t {
+    bool direct;          /**< The current update is written to the scratch
+                           *   metadata block instead of being journaled
+                           */
+    bool torn;            /**< A record interrupted by a power failure leaves
+                           *   no free record slot
+                           */
+    uint8_t num_records;  /**< Number of records in the active metadata block */
+    uint16_t file_idx[ITS_METADATA_JOURNAL_RECORDS][ITS_JOURNAL_MAX_FILES];
+                          /**< File metadata entries updated by each record */
+    uint16_t lblock[ITS_METADATA_JOURNAL_RECORDS]; /**< Logical block updated
+                                                    *   by each record
+                                                    */
+    struct its_journal_record_t update; /**< Record of the current update */
+};
+#else
+#define ITS_METADATA_JOURNAL_SIZE 0
+#endif /* ITS_METADATA_JOURNAL_RECORDS > 0 */
+
 /**
  * \struct its_flash_fs_ctx_t
  *
@@ -192,6 +271,15 @@ struct its_flash_fs_ctx_t {
                                                            */
     uint32_t active_metablock;  /**< Active metadata block */
     uint32_t scratch_metablock; /**< Scratch metadata block */
+#if ITS_FILE_INDEX
+    struct its_flash_fs_index_t file_index; /**< RAM index of the file
+                                             *   metadata in the active
+                                             *   metadata block
+                                             */
+#endif
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+    struct its_flash_fs_journal_t journal; /**< Metadata journal state */
+#endif
 };
 
 /**
@@ -260,6 +348,17 @@ psa_status_t its_flash_fs_mblock_get_file_idx_flag(
                                               uint32_t flags,
                                               uint32_t *idx);
 
+#if ITS_METADATA_JOURNAL_RECORDS > 0
+/**
+ * \brief Starts an update operation, discarding the metadata entries written
+ *        by an update which did not complete.
+ *        First step when a create/write/delete is performed.
+ *
+ * \param[in,out] fs_ctx  Filesystem context
+ */
+void its_flash_fs_mblock_meta_update_start(struct its_flash_fs_ctx_t *fs_ctx);
+#endif
+
 /**
  * \brief Finalizes an update operation.
  *        Last step when a create/write/delete is performed.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -9,6 +9,7 @@
 
 #include "flash_fs/its_flash_fs.h"
 #include "flash/its_flash.h"
+#include "its_crypto_interface.h"
 #include "its_utils.h"
 #include "psa_manifest/pid.h"
 #include "tfm_hal_its_encryption.h"
@@ -164,3 +165,74 @@ psa_status_t tfm_its_crypt_file(struct its_flash_fs_file_info_t *finfo,
     return PSA_SUCCESS;
 }
 
+#if TFM_ITS_ENC_CHUNK_SIZE != 0
+psa_status_t tfm_its_crypt_chunk(uint8_t *fid,
+                                 const size_t fid_size,
+                                 const uint32_t flags,
+                                 const size_t file_size,
+                                 const uint32_t chunk_idx,
+                                 const uint8_t *input,
+                                 const size_t size,
+                                 uint8_t *output,
+                                 uint8_t *nonce,
+                                 uint8_t *tag,
+                                 const bool is_encrypt)
+{
+    struct tfm_hal_its_auth_crypt_ctx aead_ctx = {0};
+    enum tfm_hal_status_t err;
+    psa_status_t status;
+    /* The file additional data followed by the chunk index */
+    uint8_t aad[ITS_FILE_ID_SIZE + ITS_DATA_SIZE_FIELD_SIZE + ITS_FLAG_SIZE +
+                sizeof(chunk_idx)];
+
+    status = tfm_its_fill_enc_add(aad,
+                                  sizeof(aad) - sizeof(chunk_idx),
+                                  fid,
+                                  fid_size,
+                                  flags,
+                                  file_size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+    memcpy(aad + sizeof(aad) - sizeof(chunk_idx), &chunk_idx,
+           sizeof(chunk_idx));
+
+    if (is_encrypt) {
+        /* A chunk is never encrypted twice with the same nonce, even when
+         * only this chunk of the file is rewritten.
+         */
+        err = tfm_hal_its_aead_generate_nonce(nonce, TFM_ITS_ENC_NONCE_LENGTH);
+        if (err != TFM_HAL_SUCCESS) {
+            return tfm_hal_to_psa_error(err);
+        }
+    }
+
+    /* Set all required parameters for the aead operation context */
+    aead_ctx.nonce = nonce;
+    aead_ctx.nonce_size = TFM_ITS_ENC_NONCE_LENGTH;
+    aead_ctx.deriv_label = fid;
+    aead_ctx.deriv_label_size = fid_size;
+    aead_ctx.aad = aad;
+    aead_ctx.aad_size = sizeof(aad);
+
+    if (is_encrypt) {
+        err = tfm_hal_its_aead_encrypt(&aead_ctx,
+                                       input,
+                                       size,
+                                       output,
+                                       size,
+                                       tag,
+                                       TFM_ITS_AUTH_TAG_LENGTH);
+    } else {
+        err = tfm_hal_its_aead_decrypt(&aead_ctx,
+                                       input,
+                                       size,
+                                       tag,
+                                       TFM_ITS_AUTH_TAG_LENGTH,
+                                       output,
+                                       size);
+    }
+
+    return tfm_hal_to_psa_error(err);
+}
+#endif /* TFM_ITS_ENC_CHUNK_SIZE != 0 */
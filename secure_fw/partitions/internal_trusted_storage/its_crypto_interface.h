@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -16,6 +16,29 @@
 #include "tfm_its_defs.h"
 #include "tfm_sp_log.h"
 
+#if TFM_ITS_ENC_CHUNK_SIZE != 0
+/* Size of the nonce and tag stored after the ciphertext of each chunk */
+#define ITS_ENC_CHUNK_OVERHEAD  (TFM_ITS_ENC_NONCE_LENGTH + \
+                                 TFM_ITS_AUTH_TAG_LENGTH)
+
+/* Size of the record stored for a full chunk */
+#define ITS_ENC_CHUNK_RECORD_SIZE  (TFM_ITS_ENC_CHUNK_SIZE + \
+                                    ITS_ENC_CHUNK_OVERHEAD)
+
+/* Number of chunks of a file with the given plaintext size */
+#define ITS_ENC_NUM_CHUNKS(size) \
+    (((size) + TFM_ITS_ENC_CHUNK_SIZE - 1) / TFM_ITS_ENC_CHUNK_SIZE)
+
+/* Size stored in the filesystem for the given plaintext size */
+#define ITS_ENC_STORED_SIZE(size) \
+    ((size) + (ITS_ENC_NUM_CHUNKS(size) * ITS_ENC_CHUNK_OVERHEAD))
+
+/* Plaintext size of a file with the given stored size */
+#define ITS_ENC_PLAIN_SIZE(stored_size) \
+    ((stored_size) - ((((stored_size) + ITS_ENC_CHUNK_RECORD_SIZE - 1) / \
+                       ITS_ENC_CHUNK_RECORD_SIZE) * ITS_ENC_CHUNK_OVERHEAD))
+#endif /* TFM_ITS_ENC_CHUNK_SIZE != 0 */
+
 /**
  * \brief Perform encryption/decryption of the buffer using the
  *        tfm_hal_its APIs
@@ -41,3 +64,42 @@ psa_status_t tfm_its_crypt_file(struct its_flash_fs_file_info_t *finfo,
                                 const size_t output_size,
                                 const bool is_encrypt);
 
+#if TFM_ITS_ENC_CHUNK_SIZE != 0
+/**
+ * \brief Perform encryption/decryption of one chunk of a file using the
+ *        tfm_hal_its APIs
+ *
+ * \details Each chunk is encrypted with its own nonce, freshly generated on
+ *          every encryption. The file ID, the file flags, the plaintext size
+ *          of the file and the chunk index are authenticated as additional
+ *          data, so chunks cannot be moved within a file or between files.
+ *
+ * \param[in]     fid         File identifier
+ * \param[in]     fid_size    File identifier size in bytes
+ * \param[in]     flags       Flags of the file
+ * \param[in]     file_size   Plaintext size of the file in bytes
+ * \param[in]     chunk_idx   Index of the chunk in the file
+ * \param[in]     input       Input buffer
+ * \param[in]     size        Input and output size in bytes
+ * \param[out]    output      Output buffer
+ * \param[in,out] nonce       Nonce of the chunk, of TFM_ITS_ENC_NONCE_LENGTH
+ *                            bytes. Written when encrypting.
+ * \param[in,out] tag         Authentication tag of the chunk, of
+ *                            TFM_ITS_AUTH_TAG_LENGTH bytes. Written when
+ *                            encrypting.
+ * \param[in]     is_encrypt  Set the operation type (encryption/decryption)
+ *
+ * \return PSA_SUCCESS on successful operation or a valid PSA error code
+ */
+psa_status_t tfm_its_crypt_chunk(uint8_t *fid,
+                                 const size_t fid_size,
+                                 const uint32_t flags,
+                                 const size_t file_size,
+                                 const uint32_t chunk_idx,
+                                 const uint8_t *input,
+                                 const size_t size,
+                                 uint8_t *output,
+                                 uint8_t *nonce,
+                                 uint8_t *tag,
+                                 const bool is_encrypt);
+#endif /* TFM_ITS_ENC_CHUNK_SIZE != 0 */
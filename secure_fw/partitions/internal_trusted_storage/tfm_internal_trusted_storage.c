@@ -1,14 +1,15 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
+#include <stdbool.h>
 #include <string.h>
 #include "psa/framework_feature.h"
-#if PSA_FRAMEWORK_HAS_MM_IOVEC != 1
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) || defined(ITS_ENCRYPTION)
 #include "cmsis_compiler.h"
 #endif
 #include "config_tfm.h"
@@ -32,6 +33,12 @@
 #include "ps_object_defs.h"
 #endif
 
+#if defined(ITS_ENCRYPTION) && (TFM_ITS_ENC_CHUNK_SIZE != 0) && \
+    defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
+/* ITS files are encrypted in chunks */
+#define ITS_CHUNKED_ENCRYPTION
+#endif
+
 #ifndef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
 extern uint8_t *p_psa_src_data;
 extern uint8_t *p_psa_dest_data;
@@ -40,12 +47,15 @@ extern uint8_t *p_psa_dest_data;
 static uint8_t g_fid[ITS_FILE_ID_SIZE];
 static struct its_flash_fs_file_info_t g_file_info;
 
-#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
-/* Buffer to store asset data from the caller.
+#if ((PSA_FRAMEWORK_HAS_MM_IOVEC != 1) || defined(ITS_ENCRYPTION)) && \
+    defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
+/* Buffer to stage asset data between the caller and the filesystem. Plain
+ * assets and assets encrypted in chunks are streamed through it, assets
+ * encrypted as a whole must fit in it.
  * Note: size must be aligned to the max flash program unit to meet the
  * alignment requirement of the filesystem.
  */
-#ifndef ITS_ENCRYPTION
+#if !defined(ITS_ENCRYPTION) || defined(ITS_CHUNKED_ENCRYPTION)
 static uint8_t __ALIGNED(4) asset_data[ITS_UTILS_ALIGN(ITS_BUF_SIZE,
                                           ITS_FLASH_MAX_ALIGNMENT)];
 #else
@@ -55,11 +65,18 @@ static uint8_t __ALIGNED(4) asset_data[ITS_UTILS_ALIGN(ITS_MAX_ASSET_SIZE,
 #endif
 
 #ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+#ifdef ITS_CHUNKED_ENCRYPTION
+/* Files also store the nonce and authentication tag of each chunk */
+#define ITS_MAX_FILE_SIZE ITS_ENC_STORED_SIZE(ITS_MAX_ASSET_SIZE)
+#else
+#define ITS_MAX_FILE_SIZE ITS_MAX_ASSET_SIZE
+#endif
+
 static its_flash_fs_ctx_t fs_ctx_its;
 static struct its_flash_fs_config_t fs_cfg_its = {
     .flash_dev = &ITS_FLASH_DEV,
     .program_unit = ITS_FLASH_ALIGNMENT,
-    .max_file_size = ITS_UTILS_ALIGN(ITS_MAX_ASSET_SIZE, ITS_FLASH_ALIGNMENT),
+    .max_file_size = ITS_UTILS_ALIGN(ITS_MAX_FILE_SIZE, ITS_FLASH_ALIGNMENT),
     .max_num_files = ITS_NUM_ASSETS + 1, /* Extra file for atomic replacement */
 };
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
@@ -89,13 +106,35 @@ static its_flash_fs_ctx_t *get_fs_ctx(int32_t client_id)
 #endif
 }
 
+#if defined(ITS_ENCRYPTION) && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
+/**
+ * \brief Checks whether the assets of a client are stored encrypted.
+ *
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ *
+ * \return true if the assets are encrypted, false otherwise
+ */
+static bool tfm_its_is_encrypted(int32_t client_id)
+{
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+    /* With protected storage no encryption is used */
+    return (client_id != TFM_SP_PS);
+#else
+    (void)client_id;
+    return true;
+#endif /* TFM_PARTITION_PROTECTED_STORAGE */
+}
+#endif /* ITS_ENCRYPTION && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
+
 #ifdef ITS_ENCRYPTION
+#ifndef ITS_CHUNKED_ENCRYPTION
 /* Buffer to store the encrypted asset data and the authentication tag before it
  * is stored in the filesystem.
  */
 static uint8_t __ALIGNED(4) enc_asset_data[ITS_UTILS_ALIGN(ITS_MAX_ASSET_SIZE +
                                            TFM_ITS_AUTH_TAG_LENGTH,
                                            ITS_FLASH_MAX_ALIGNMENT)];
+#endif /* !ITS_CHUNKED_ENCRYPTION */
 
 static psa_status_t buffer_size_check(int32_t client_id, size_t buffer_size)
 {
@@ -115,6 +154,7 @@ static psa_status_t buffer_size_check(int32_t client_id, size_t buffer_size)
     return PSA_SUCCESS;
 }
 
+#ifndef ITS_CHUNKED_ENCRYPTION
 static psa_status_t tfm_its_crypt_data(int32_t client_id,
                                 uint8_t **input,
                                 size_t input_size,
@@ -194,6 +234,7 @@ static psa_status_t tfm_its_get_encrypted(int32_t client_id,
 
     return PSA_SUCCESS;
 }
+#endif /* !ITS_CHUNKED_ENCRYPTION */
 #endif /* ITS_ENCRYPTION */
 
 /**
@@ -211,6 +252,364 @@ static void tfm_its_get_fid(int32_t client_id,
     memcpy(fid + sizeof(client_id), (const void *)&uid, sizeof(uid));
 }
 
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
+/**
+ * \brief Reads the next part of the asset data from the caller.
+ *
+ * \param[out] buf   Buffer to store the data
+ * \param[in]  size  Number of bytes to read
+ *
+ * \return Returns PSA_ERROR_PROGRAMMER_ERROR if the caller provided less data
+ *         than requested, and PSA_SUCCESS otherwise.
+ */
+static psa_status_t tfm_its_read_from_client(uint8_t *buf, size_t size)
+{
+    if (its_req_mngr_read(buf, size) != size) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Writes the next part of the asset data to the caller.
+ *
+ * \param[in] buf   Buffer containing the data
+ * \param[in] size  Number of bytes to write
+ *
+ * \return Returns PSA_SUCCESS
+ */
+static psa_status_t tfm_its_write_to_client(const uint8_t *buf, size_t size)
+{
+    its_req_mngr_write(buf, size);
+
+    return PSA_SUCCESS;
+}
+#endif /* (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
+
+#ifdef ITS_CHUNKED_ENCRYPTION
+/*!
+ * \struct its_chunk_ctx_t
+ *
+ * \brief State of the chunked encryption or decryption of a file.
+ */
+struct its_chunk_ctx_t {
+    int32_t client_id;   /*!< Identifier of the asset's owner (client) */
+    size_t file_size;    /*!< Plaintext size of the file */
+    size_t data_offset;  /*!< Offset in the file of the caller's data */
+    size_t data_size;    /*!< Size of the caller's data */
+    uint32_t chunk_idx;  /*!< Index of the chunk being processed */
+    size_t record_pos;   /*!< Position in chunk_record */
+    size_t record_size;  /*!< Size of the record in chunk_record */
+};
+
+static struct its_chunk_ctx_t g_chunk_ctx;
+
+/* Plaintext of the chunk being processed */
+static uint8_t chunk_data[TFM_ITS_ENC_CHUNK_SIZE];
+
+/* Record of the chunk being processed: ciphertext, nonce and tag */
+static uint8_t chunk_record[ITS_ENC_CHUNK_RECORD_SIZE];
+
+/**
+ * \brief Gets the plaintext size of a chunk of the current file.
+ *
+ * \param[in] chunk_idx  Index of the chunk
+ *
+ * \return Size of the chunk in bytes, 0 if it is past the end of the file
+ */
+static size_t tfm_its_chunk_size(uint32_t chunk_idx)
+{
+    size_t chunk_start = (size_t)chunk_idx * TFM_ITS_ENC_CHUNK_SIZE;
+
+    if (chunk_start >= g_chunk_ctx.file_size) {
+        return 0;
+    }
+
+    return ITS_UTILS_MIN(TFM_ITS_ENC_CHUNK_SIZE,
+                         g_chunk_ctx.file_size - chunk_start);
+}
+
+/**
+ * \brief Encrypts or decrypts the chunk being processed, between chunk_data
+ *        and chunk_record.
+ *
+ * \param[in] is_encrypt  Set the operation type (encryption/decryption)
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_crypt_cur_chunk(bool is_encrypt)
+{
+    size_t size = tfm_its_chunk_size(g_chunk_ctx.chunk_idx);
+
+    return tfm_its_crypt_chunk(g_fid, sizeof(g_fid), g_file_info.flags,
+                               g_chunk_ctx.file_size, g_chunk_ctx.chunk_idx,
+                               is_encrypt ? chunk_data : chunk_record,
+                               size,
+                               is_encrypt ? chunk_record : chunk_data,
+                               chunk_record + size,
+                               chunk_record + size + TFM_ITS_ENC_NONCE_LENGTH,
+                               is_encrypt);
+}
+
+/**
+ * \brief Prepares the record of the next chunk to be written. The caller's
+ *        data in the chunk is merged with the current content of the chunk
+ *        if the chunk is only partly written.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_next_enc_record(void)
+{
+    psa_status_t status;
+    size_t chunk_start = (size_t)g_chunk_ctx.chunk_idx * TFM_ITS_ENC_CHUNK_SIZE;
+    size_t chunk_size = tfm_its_chunk_size(g_chunk_ctx.chunk_idx);
+    size_t start = ITS_UTILS_MAX(chunk_start, g_chunk_ctx.data_offset);
+    size_t end = ITS_UTILS_MIN(chunk_start + chunk_size,
+                               g_chunk_ctx.data_offset + g_chunk_ctx.data_size);
+
+    if ((start != chunk_start) || (end != chunk_start + chunk_size)) {
+        /* Decrypt the current content of the chunk */
+        status = its_flash_fs_file_read(get_fs_ctx(g_chunk_ctx.client_id),
+                                        g_fid,
+                                        chunk_size + ITS_ENC_CHUNK_OVERHEAD,
+                                        (size_t)g_chunk_ctx.chunk_idx *
+                                        ITS_ENC_CHUNK_RECORD_SIZE,
+                                        chunk_record);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        status = tfm_its_crypt_cur_chunk(false);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    /* Read the caller's data in the chunk */
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    memcpy(chunk_data + (start - chunk_start),
+           its_req_mngr_get_vec_base() + (start - g_chunk_ctx.data_offset),
+           end - start);
+#else
+    status = tfm_its_read_from_client(chunk_data + (start - chunk_start),
+                                      end - start);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+    status = tfm_its_crypt_cur_chunk(true);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    g_chunk_ctx.chunk_idx++;
+    g_chunk_ctx.record_pos = 0;
+    g_chunk_ctx.record_size = chunk_size + ITS_ENC_CHUNK_OVERHEAD;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Provides the next part of the encrypted records to the filesystem.
+ *
+ * \param[out] buf   Buffer to store the data
+ * \param[in]  size  Number of bytes to provide
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_enc_read_data(uint8_t *buf, size_t size)
+{
+    psa_status_t status;
+    size_t num_bytes;
+
+    while (size > 0) {
+        if (g_chunk_ctx.record_pos == g_chunk_ctx.record_size) {
+            status = tfm_its_next_enc_record();
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+
+        num_bytes = ITS_UTILS_MIN(size, g_chunk_ctx.record_size -
+                                        g_chunk_ctx.record_pos);
+        memcpy(buf, chunk_record + g_chunk_ctx.record_pos, num_bytes);
+
+        g_chunk_ctx.record_pos += num_bytes;
+        buf += num_bytes;
+        size -= num_bytes;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Decrypts the record of the chunk being read and passes the requested
+ *        part of it to the caller.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_dec_record(void)
+{
+    psa_status_t status;
+    size_t chunk_start = (size_t)g_chunk_ctx.chunk_idx * TFM_ITS_ENC_CHUNK_SIZE;
+    size_t chunk_size = tfm_its_chunk_size(g_chunk_ctx.chunk_idx);
+    size_t start = ITS_UTILS_MAX(chunk_start, g_chunk_ctx.data_offset);
+    size_t end = ITS_UTILS_MIN(chunk_start + chunk_size,
+                               g_chunk_ctx.data_offset + g_chunk_ctx.data_size);
+
+    status = tfm_its_crypt_cur_chunk(false);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Write the requested data in the chunk to the caller */
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    memcpy(its_req_mngr_get_vec_base() + (start - g_chunk_ctx.data_offset),
+           chunk_data + (start - chunk_start), end - start);
+#else
+    its_req_mngr_write(chunk_data + (start - chunk_start), end - start);
+#endif
+
+    g_chunk_ctx.chunk_idx++;
+    g_chunk_ctx.record_pos = 0;
+    g_chunk_ctx.record_size = tfm_its_chunk_size(g_chunk_ctx.chunk_idx) +
+                              ITS_ENC_CHUNK_OVERHEAD;
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Consumes the next part of the encrypted records read from the
+ *        filesystem.
+ *
+ * \param[in] buf   Buffer containing the data
+ * \param[in] size  Number of bytes in the buffer
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_dec_write_data(const uint8_t *buf, size_t size)
+{
+    psa_status_t status;
+    size_t num_bytes;
+
+    while (size > 0) {
+        num_bytes = ITS_UTILS_MIN(size, g_chunk_ctx.record_size -
+                                        g_chunk_ctx.record_pos);
+        memcpy(chunk_record + g_chunk_ctx.record_pos, buf, num_bytes);
+
+        g_chunk_ctx.record_pos += num_bytes;
+        buf += num_bytes;
+        size -= num_bytes;
+
+        if (g_chunk_ctx.record_pos == g_chunk_ctx.record_size) {
+            status = tfm_its_dec_record();
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Sets up the chunked processing of a range of the current file.
+ *
+ * \param[in]  client_id      Identifier of the asset's owner (client)
+ * \param[in]  file_size      Plaintext size of the file
+ * \param[in]  data_offset    Offset of the range in the file
+ * \param[in]  data_size      Size of the range, must not be 0
+ * \param[out] stored_offset  Offset of the records covering the range
+ * \param[out] stored_size    Size of the records covering the range
+ */
+static void tfm_its_chunk_range(int32_t client_id,
+                                size_t file_size,
+                                size_t data_offset,
+                                size_t data_size,
+                                size_t *stored_offset,
+                                size_t *stored_size)
+{
+    uint32_t first = data_offset / TFM_ITS_ENC_CHUNK_SIZE;
+    size_t start = (size_t)first * TFM_ITS_ENC_CHUNK_SIZE;
+    size_t end = ITS_UTILS_MIN(ITS_ENC_NUM_CHUNKS(data_offset + data_size) *
+                               TFM_ITS_ENC_CHUNK_SIZE, file_size);
+
+    g_chunk_ctx.client_id = client_id;
+    g_chunk_ctx.file_size = file_size;
+    g_chunk_ctx.data_offset = data_offset;
+    g_chunk_ctx.data_size = data_size;
+    g_chunk_ctx.chunk_idx = first;
+    g_chunk_ctx.record_pos = 0;
+    g_chunk_ctx.record_size = 0;
+
+    *stored_offset = (size_t)first * ITS_ENC_CHUNK_RECORD_SIZE;
+    *stored_size = ITS_ENC_STORED_SIZE(end - start);
+}
+
+/**
+ * \brief Writes the caller's data to a range of the current file, encrypting
+ *        only the chunks covering the range.
+ *
+ * \param[in] client_id    Identifier of the asset's owner (client)
+ * \param[in] file_size    Plaintext size of the file
+ * \param[in] data_offset  Offset in the file of the caller's data
+ * \param[in] data_size    Size of the caller's data
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t tfm_its_write_chunks(int32_t client_id,
+                                         size_t file_size,
+                                         size_t data_offset,
+                                         size_t data_size)
+{
+    size_t stored_offset = 0;
+    size_t stored_size = 0;
+
+    if (data_size != 0) {
+        tfm_its_chunk_range(client_id, file_size, data_offset, data_size,
+                            &stored_offset, &stored_size);
+    }
+
+    return its_flash_fs_file_write_stream(get_fs_ctx(client_id), g_fid,
+                                          &g_file_info, stored_size,
+                                          stored_offset, tfm_its_enc_read_data,
+                                          asset_data, sizeof(asset_data));
+}
+
+static psa_status_t tfm_its_get_encrypted(int32_t client_id,
+                         size_t data_offset,
+                         size_t data_size,
+                         size_t *p_data_length)
+{
+    psa_status_t status;
+    size_t stored_offset;
+    size_t stored_size;
+
+    if (data_size == 0) {
+        return PSA_SUCCESS;
+    }
+
+    /* Only read and decrypt the chunks covering the requested data */
+    tfm_its_chunk_range(client_id, g_file_info.size_current, data_offset,
+                        data_size, &stored_offset, &stored_size);
+    g_chunk_ctx.record_size = tfm_its_chunk_size(g_chunk_ctx.chunk_idx) +
+                              ITS_ENC_CHUNK_OVERHEAD;
+
+    status = its_flash_fs_file_read_stream(get_fs_ctx(client_id), g_fid,
+                                           stored_size, stored_offset,
+                                           tfm_its_dec_write_data,
+                                           asset_data, sizeof(asset_data));
+    if (status != PSA_SUCCESS) {
+        *p_data_length = 0;
+        return status;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* ITS_CHUNKED_ENCRYPTION */
+
 #ifdef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
 /**
  * \brief Initialise the static ITS filesystem configurations.
@@ -389,11 +788,28 @@ static psa_status_t get_file_info(psa_storage_uid_t uid, int32_t client_id)
     tfm_its_get_fid(client_id, uid, g_fid);
 
     /* Read file info */
+#ifdef ITS_CHUNKED_ENCRYPTION
+    psa_status_t status = its_flash_fs_file_get_info(get_fs_ctx(client_id),
+                                                     g_fid, &g_file_info);
+    if ((status == PSA_SUCCESS) && tfm_its_is_encrypted(client_id)) {
+        /* Report the sizes of the plaintext rather than of the records. An
+         * encrypted file is always created with the size of its data, so its
+         * plaintext capacity is its current size. The stored maximum size is
+         * aligned to the flash program unit and would overstate it.
+         */
+        g_file_info.size_current = ITS_ENC_PLAIN_SIZE(g_file_info.size_current);
+        g_file_info.size_max = g_file_info.size_current;
+    }
+
+    return status;
+#else
     return its_flash_fs_file_get_info(get_fs_ctx(client_id), g_fid,
                                       &g_file_info);
+#endif /* ITS_CHUNKED_ENCRYPTION */
 }
 
-
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC == 1) || \
+    (defined(ITS_ENCRYPTION) && !defined(ITS_CHUNKED_ENCRYPTION))
 static psa_status_t tfm_its_write_data_to_fs(const int32_t client_id,
                                      const uint8_t *fid,
                                      struct its_flash_fs_file_info_t *finfo,
@@ -403,12 +819,12 @@ static psa_status_t tfm_its_write_data_to_fs(const int32_t client_id,
 {
     psa_status_t status;
     uint8_t *buffer_ptr = data;
-#ifdef ITS_ENCRYPTION /* ITS_ENCRYPTION */
+#if defined(ITS_ENCRYPTION) && !defined(ITS_CHUNKED_ENCRYPTION)
     status = tfm_its_crypt_data(client_id, &buffer_ptr, data_size, offset);
     if (status != PSA_SUCCESS) {
         return status;
     }
-#endif /* ITS_ENCRYPTION */
+#endif /* ITS_ENCRYPTION && !ITS_CHUNKED_ENCRYPTION */
     status = its_flash_fs_file_write(get_fs_ctx(client_id),
                                         fid,
                                         &g_file_info,
@@ -419,6 +835,9 @@ static psa_status_t tfm_its_write_data_to_fs(const int32_t client_id,
 
     return PSA_SUCCESS;
 }
+#endif /* (PSA_FRAMEWORK_HAS_MM_IOVEC == 1) ||
+        * (ITS_ENCRYPTION && !ITS_CHUNKED_ENCRYPTION)
+        */
 
 psa_status_t tfm_its_set(int32_t client_id,
                          psa_storage_uid_t uid,
@@ -426,10 +845,6 @@ psa_status_t tfm_its_set(int32_t client_id,
                          psa_storage_create_flags_t create_flags)
 {
     psa_status_t status;
-#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
-    size_t write_size;
-    size_t offset;
-#endif
 
     /* Check that the UID is valid */
     if (uid == TFM_ITS_INVALID_UID) {
@@ -470,6 +885,14 @@ psa_status_t tfm_its_set(int32_t client_id,
     g_file_info.flags = (uint32_t)create_flags |
                         ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE;
 
+#ifdef ITS_CHUNKED_ENCRYPTION
+    if (tfm_its_is_encrypted(client_id)) {
+        /* The file stores the encrypted record of each chunk */
+        g_file_info.size_max = ITS_ENC_STORED_SIZE(data_length);
+
+        return tfm_its_write_chunks(client_id, data_length, 0, data_length);
+    }
+#endif /* ITS_CHUNKED_ENCRYPTION */
 
 #ifndef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
     /* Write to the file in the file system
@@ -485,30 +908,91 @@ psa_status_t tfm_its_set(int32_t client_id,
                                       data_length, 0,
                                       its_req_mngr_get_vec_base());
 #else
-    offset = 0;
+#if defined(ITS_ENCRYPTION) && !defined(ITS_CHUNKED_ENCRYPTION)
+    if (tfm_its_is_encrypted(client_id)) {
+        /* The whole asset is encrypted at once. It fits in the asset_data
+         * buffer, as checked by buffer_size_check().
+         */
+        (void)its_req_mngr_read(asset_data, data_length);
 
-    /* Iteratively read data from the caller and write it to the filesystem, in
-     * chunks no larger than the size of the asset_data buffer.
+        return tfm_its_write_data_to_fs(client_id, g_fid, &g_file_info,
+                                        data_length, 0, asset_data);
+    }
+#endif /* ITS_ENCRYPTION && !ITS_CHUNKED_ENCRYPTION */
+
+    /* Stream the data from the caller to the filesystem, in chunks no larger
+     * than the size of the asset_data buffer, as a single file update.
      */
-    do {
-        /* Write as much of the data as will fit in the asset_data buffer */
-        write_size = ITS_UTILS_MIN(data_length, sizeof(asset_data));
+    status = its_flash_fs_file_write_stream(get_fs_ctx(client_id), g_fid,
+                                            &g_file_info, data_length, 0,
+                                            tfm_its_read_from_client,
+                                            asset_data, sizeof(asset_data));
+#endif
+
+    return status;
+}
+
+psa_status_t tfm_its_update(int32_t client_id,
+                            psa_storage_uid_t uid,
+                            size_t data_offset,
+                            size_t data_length)
+{
+    psa_status_t status;
 
-        /* Read asset data from the caller */
-        (void)its_req_mngr_read(asset_data, write_size);
+    /* Validate and read file info */
+    status = get_file_info(uid, client_id);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
 
-        status = tfm_its_write_data_to_fs(client_id, g_fid, &g_file_info,
-                                          write_size, offset, asset_data);
+    /* If the object has the write once flag set, then it cannot be modified */
+    if (g_file_info.flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
 
-        if (status != PSA_SUCCESS) {
-                return status;
-        }
-        /* Do not create or truncate after the first iteration */
-        g_file_info.flags &= ~(ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE);
+    /* Only the existing data of the asset can be updated */
+    if (its_utils_check_contained_in(g_file_info.size_current, data_offset,
+                                     data_length) != PSA_SUCCESS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
 
-        offset += write_size;
-        data_length -= write_size;
-    } while (data_length > 0);
+#if defined ITS_ENCRYPTION && defined TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+#ifndef ITS_CHUNKED_ENCRYPTION
+    /* Encrypted assets are authenticated as a whole */
+    if (tfm_its_is_encrypted(client_id)) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+#endif /* !ITS_CHUNKED_ENCRYPTION */
+#endif /* ITS_ENCRYPTION && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
+
+    if (data_length == 0) {
+        return PSA_SUCCESS;
+    }
+
+    /* Update the existing file in place */
+    g_file_info.flags &= ~(ITS_FLASH_FS_FLAG_CREATE | ITS_FLASH_FS_FLAG_TRUNCATE);
+
+#ifdef ITS_CHUNKED_ENCRYPTION
+    if (tfm_its_is_encrypted(client_id)) {
+        /* Only the chunks covering the updated data are re-encrypted */
+        return tfm_its_write_chunks(client_id, g_file_info.size_current,
+                                    data_offset, data_length);
+    }
+#endif /* ITS_CHUNKED_ENCRYPTION */
+
+#ifndef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+    status = its_flash_fs_file_write(get_fs_ctx(client_id), g_fid, &g_file_info,
+                                     data_length, data_offset, p_psa_src_data);
+#elif PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    status = its_flash_fs_file_write(get_fs_ctx(client_id), g_fid, &g_file_info,
+                                     data_length, data_offset,
+                                     its_req_mngr_get_vec_base());
+#else
+    status = its_flash_fs_file_write_stream(get_fs_ctx(client_id), g_fid,
+                                            &g_file_info, data_length,
+                                            data_offset,
+                                            tfm_its_read_from_client,
+                                            asset_data, sizeof(asset_data));
 #endif
 
     return status;
@@ -521,10 +1005,6 @@ static psa_status_t tfm_its_get_plain(int32_t client_id,
 {
     psa_status_t status;
 
-#if (PSA_FRAMEWORK_HAS_MM_IOVEC != 1) && defined(TFM_PARTITION_INTERNAL_TRUSTED_STORAGE)
-    size_t read_size;
-#endif
-
 #ifndef TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
     /* Read file data from the filesystem */
     status = its_flash_fs_file_read(get_fs_ctx(client_id), g_fid, data_size,
@@ -545,27 +1025,17 @@ static psa_status_t tfm_its_get_plain(int32_t client_id,
 
 #else
 
-    /* Iteratively read data from the filesystem and write it to the caller, in
-     * chunks no larger than the size of the asset_data buffer.
+    /* Stream the data from the filesystem to the caller, in chunks no larger
+     * than the size of the asset_data buffer.
      */
-    do {
-        /* Read as much of the data as will fit in the asset_data buffer */
-        read_size = ITS_UTILS_MIN(data_size, sizeof(asset_data));
-
-        /* Read file data from the filesystem */
-        status = its_flash_fs_file_read(get_fs_ctx(client_id), g_fid, read_size,
-                                        data_offset, asset_data);
-        if (status != PSA_SUCCESS) {
-            *p_data_length = 0;
-            return status;
-        }
-
-        /* Write asset data to the caller */
-        its_req_mngr_write(asset_data, read_size);
-
-        data_offset += read_size;
-        data_size -= read_size;
-    } while (data_size > 0);
+    status = its_flash_fs_file_read_stream(get_fs_ctx(client_id), g_fid,
+                                           data_size, data_offset,
+                                           tfm_its_write_to_client,
+                                           asset_data, sizeof(asset_data));
+    if (status != PSA_SUCCESS) {
+        *p_data_length = 0;
+        return status;
+    }
 #endif /* TFM_PARTITION_INTERNAL_TRUSTED_STORAGE & PSA_FRAMEWORK_HAS_MM_IOVEC */
 
     return PSA_SUCCESS;
@@ -593,12 +1063,15 @@ psa_status_t tfm_its_get(int32_t client_id,
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-#if defined ITS_ENCRYPTION && defined TFM_PARTITION_INTERNAL_TRUSTED_STORAGE
+#if defined ITS_ENCRYPTION && defined TFM_PARTITION_INTERNAL_TRUSTED_STORAGE && \
+    !defined(ITS_CHUNKED_ENCRYPTION)
     status = buffer_size_check(client_id, data_offset + data_size);
     if (status != PSA_SUCCESS) {
         return status;
     }
-#endif /* ITS_ENCRYPTION && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE */
+#endif /* ITS_ENCRYPTION && TFM_PARTITION_INTERNAL_TRUSTED_STORAGE &&
+        * !ITS_CHUNKED_ENCRYPTION
+        */
 
     /* Read file info */
     status = get_file_info(uid, client_id);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -71,6 +71,43 @@ psa_status_t tfm_its_set(int32_t client_id,
                          size_t data_length,
                          psa_storage_create_flags_t create_flags);
 
+/**
+ * \brief Update part of the data of an existing uid/value pair
+ *
+ * Overwrites `data_length` bytes of the data associated with `uid`, starting
+ * at `data_offset` bytes from the beginning of the data. The data is streamed
+ * from the caller to the storage, and the update is atomic.
+ *
+ * \param[in] client_id    Identifier of the asset's owner (client)
+ * \param[in] uid          The identifier for the data
+ * \param[in] data_offset  The offset within the data at which to write
+ * \param[in] data_length  The size in bytes of the data in `p_data`
+ *
+ * \return A status indicating the success/failure of the operation
+ *
+ * \retval PSA_SUCCESS                 The operation completed successfully
+ * \retval PSA_ERROR_DOES_NOT_EXIST    The operation failed because the
+ *                                     provided `uid` value was not found in
+ *                                     the storage
+ * \retval PSA_ERROR_NOT_PERMITTED     The operation failed because the provided
+ *                                     uid value was created with
+ *                                     PSA_STORAGE_FLAG_WRITE_ONCE
+ * \retval PSA_ERROR_NOT_SUPPORTED     The operation failed because the asset
+ *                                     is stored encrypted as a whole, so it
+ *                                     can only be written as a whole
+ * \retval PSA_ERROR_STORAGE_FAILURE   The operation failed because the
+ *                                     physical storage has failed (Fatal
+ *                                     error)
+ * \retval PSA_ERROR_INVALID_ARGUMENT  The operation failed because the range
+ *                                     `data_offset` to `data_offset` +
+ *                                     `data_length` is not within the current
+ *                                     size of the data associated with `uid`
+ */
+psa_status_t tfm_its_update(int32_t client_id,
+                            psa_storage_uid_t uid,
+                            size_t data_offset,
+                            size_t data_length);
+
 /**
  * \brief Retrieve data associated with a provided UID
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -60,6 +60,41 @@ static psa_status_t tfm_its_set_req(const psa_msg_t *msg)
     return tfm_its_set(msg->client_id, uid, data_length, create_flags);
 }
 
+static psa_status_t tfm_its_set_extended_req(const psa_msg_t *msg)
+{
+    psa_storage_uid_t uid;
+    size_t data_offset;
+    size_t num;
+    size_t data_length;
+
+    if (msg->in_size[0] != sizeof(uid) ||
+        msg->in_size[2] != sizeof(data_offset)) {
+        /* The size of one of the arguments is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg->handle, 0, &uid, sizeof(uid));
+    if (num != sizeof(uid)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg->handle, 2, &data_offset, sizeof(data_offset));
+    if (num != sizeof(data_offset)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+    data_length = msg->in_size[1];
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    if (data_length) {
+        p_data = (uint8_t *)psa_map_invec(msg->handle, 1);
+    } else {
+        p_data = NULL;
+    }
+#else
+    handle = msg->handle;
+#endif
+    return tfm_its_update(msg->client_id, uid, data_offset, data_length);
+}
+
 static psa_status_t tfm_its_get_req(const psa_msg_t *msg)
 {
     psa_status_t status;
@@ -163,6 +198,8 @@ psa_status_t tfm_internal_trusted_storage_service_sfn(const psa_msg_t *msg)
         return tfm_its_get_info_req(msg);
     case TFM_ITS_REMOVE:
         return tfm_its_remove_req(msg);
+    case TFM_ITS_SET_EXTENDED:
+        return tfm_its_set_extended_req(msg);
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021-2024 Cypress Semiconductor Corporation (an Infineon company)
  * or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
  *
@@ -67,24 +67,27 @@ __STATIC_INLINE bool get_spe_queue_empty_status(uint8_t idx)
     return false;
 }
 
-__STATIC_INLINE mailbox_queue_status_t get_nspe_queue_pend_status(
-                                    const struct mailbox_status_t *ns_status)
+/*
+ * A NS slot is pending when NSPE has rung its request doorbell since SPE
+ * consumed the last request from it.
+ */
+__STATIC_INLINE bool is_nspe_slot_pend(uint8_t idx)
 {
-    return ns_status->pend_slots;
+    return spe_mailbox_queue.ns_slots[idx].req_seq !=
+           spe_mailbox_queue.ns_req_seq[idx];
 }
 
-__STATIC_INLINE void set_nspe_queue_replied_status(
-                                            struct mailbox_status_t *ns_status,
-                                            mailbox_queue_status_t mask)
+/* Consume the request in a NS slot. Returns the request doorbell value. */
+__STATIC_INLINE uint32_t consume_nspe_slot_req(uint8_t idx)
 {
-    ns_status->replied_slots |= mask;
-}
+    uint32_t seq = spe_mailbox_queue.ns_slots[idx].req_seq;
 
-__STATIC_INLINE void clear_nspe_queue_pend_status(
-                                            struct mailbox_status_t *ns_status,
-                                            mailbox_queue_status_t mask)
-{
-    ns_status->pend_slots &= ~mask;
+    spe_mailbox_queue.ns_req_seq[idx] = seq;
+
+    /* Read the message only after the doorbell */
+    __DMB();
+
+    return seq;
 }
 
 __STATIC_INLINE int32_t get_spe_mailbox_msg_handle(uint8_t idx,
@@ -138,10 +141,37 @@ __STATIC_INLINE struct mailbox_reply_t *get_nspe_reply_addr(uint8_t idx)
     return &spe_mailbox_queue.ns_slots[ns_slot_idx].reply;
 }
 
+/* Count the messages of a batch which are still in process */
+static uint32_t batch_outstanding(uint32_t batch_id)
+{
+    uint32_t count = 0;
+    uint8_t idx;
+
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        if (!get_spe_queue_empty_status(idx) &&
+            (spe_mailbox_queue.queue[idx].batch_id == batch_id)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Check whether all the messages of a batch are replied, so that NSPE is
+ * notified once for the whole batch. A message which is not part of a batch
+ * is notified on its own reply.
+ */
+__STATIC_INLINE bool is_batch_replied(uint32_t batch_id)
+{
+    return (batch_id == MAILBOX_NO_BATCH) || (batch_outstanding(batch_id) == 0);
+}
+
 static void mailbox_direct_reply(uint8_t idx, uint32_t result)
 {
     struct mailbox_reply_t *reply_ptr;
     uint32_t ret_result = result;
+    uint8_t ns_slot_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
 
     /* Copy outvec lengths back if necessary */
     if ((vectors[idx].in_use) && (result == PSA_SUCCESS)) {
@@ -157,12 +187,33 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
     spm_memcpy(&reply_ptr->return_val, &ret_result,
                sizeof(reply_ptr->return_val));
 
-    mailbox_clean_queue_slot(idx);
-
     /*
-     * Skip NSPE queue status update after single reply.
-     * Update NSPE queue status after all the mailbox messages are completed
+     * Ring the reply doorbell after the result is visible. Only SPE writes to
+     * the reply part of the slot, so no lock shared with NSPE is required.
      */
+    __DMB();
+    spe_mailbox_queue.ns_slots[ns_slot_idx].reply_seq =
+                                        spe_mailbox_queue.queue[idx].req_seq;
+
+    mailbox_clean_queue_slot(idx);
+}
+
+/*
+ * Check whether a vector lies entirely inside the NS shared memory region,
+ * which has been validated during initialization.
+ */
+__STATIC_INLINE bool is_in_ns_shm(const void *base, size_t len)
+{
+    uintptr_t shm_start = (uintptr_t)spe_mailbox_queue.ns_shm_base;
+    size_t shm_size = spe_mailbox_queue.ns_shm_size;
+
+    /* An empty vector is never accessed */
+    if (len == 0) {
+        return true;
+    }
+
+    return (shm_size != 0) && ((uintptr_t)base >= shm_start) &&
+           (len <= shm_size) && ((uintptr_t)base - shm_start <= shm_size - len);
 }
 
 __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
@@ -180,6 +231,7 @@ static int local_copy_vects(const struct psa_client_params_t *params,
                             uint32_t *control)
 {
     size_t in_len, out_len;
+    bool in_shm = true;
 
     in_len = params->psa_call_params.in_len;
     out_len = params->psa_call_params.out_len;
@@ -198,6 +250,8 @@ static int local_copy_vects(const struct psa_client_params_t *params,
     for (unsigned int i = 0; i < PSA_MAX_IOVEC; i++) {
         if (i < in_len) {
             vectors[idx].in_vec[i] = params->psa_call_params.in_vec[i];
+            in_shm = in_shm && is_in_ns_shm(vectors[idx].in_vec[i].base,
+                                            vectors[idx].in_vec[i].len);
         } else {
             vectors[idx].in_vec[i].base = 0;
             vectors[idx].in_vec[i].len = 0;
@@ -207,6 +261,8 @@ static int local_copy_vects(const struct psa_client_params_t *params,
     for (unsigned int i = 0; i < PSA_MAX_IOVEC; i++) {
         if (i < out_len) {
             vectors[idx].out_vec[i] = params->psa_call_params.out_vec[i];
+            in_shm = in_shm && is_in_ns_shm(vectors[idx].out_vec[i].base,
+                                            vectors[idx].out_vec[i].len);
         } else {
             vectors[idx].out_vec[i].base = 0;
             vectors[idx].out_vec[i].len = 0;
@@ -216,6 +272,14 @@ static int local_copy_vects(const struct psa_client_params_t *params,
     *control = PARAM_SET_NS_INVEC(*control);
     *control = PARAM_SET_NS_OUTVEC(*control);
 
+    /*
+     * The local copies are checked, so NSPE cannot move the vectors out of the
+     * shared memory region after the check.
+     */
+    if (in_shm && (spe_mailbox_queue.ns_shm_size != 0)) {
+        *control = PARAM_SET_SHM_VEC(*control);
+    }
+
     vectors[idx].out_len = out_len;
     vectors[idx].original_out_vec = params->psa_call_params.out_vec;
 
@@ -225,11 +289,9 @@ static int local_copy_vects(const struct psa_client_params_t *params,
 
 /* Passes the request from the mailbox message into SPM.
  * idx indicates the slot used to use for any immediate reply.
- * If it queues the reply immediately, updates reply_slots accordingly.
  */
 static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
-                                    uint8_t idx,
-                                    mailbox_queue_status_t *reply_slots)
+                                    uint8_t idx)
 {
     const struct psa_client_params_t *params = &msg_ptr->params;
     struct client_params_t client_params = {0};
@@ -326,9 +388,11 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
         return MAILBOX_INVAL_PARAMS;
     }
 
-    /* Any synchronous result should be returned immediately */
+    /*
+     * Any synchronous result should be returned immediately. NSPE is notified
+     * once all the messages handled together are dispatched.
+     */
     if (sync) {
-        *reply_slots |= (1 << idx);
         mailbox_direct_reply(idx, (uint32_t)psa_ret);
     }
 
@@ -338,27 +402,16 @@ static int32_t tfm_mailbox_dispatch(const struct mailbox_msg_t *msg_ptr,
 int32_t tfm_mailbox_handle_msg(void)
 {
     uint8_t idx;
-    mailbox_queue_status_t mask_bits, pend_slots, reply_slots = 0;
-    struct mailbox_status_t *ns_status = spe_mailbox_queue.ns_status;
+    mailbox_queue_status_t pend_slots = 0;
+    mailbox_queue_status_t replied_slots = 0;
+    uint32_t batch_ids[NUM_MAILBOX_QUEUE_SLOT];
     struct mailbox_msg_t *msg_ptr;
 
-    SPM_ASSERT(ns_status != NULL);
-
-    tfm_mailbox_hal_enter_critical();
-
-    pend_slots = get_nspe_queue_pend_status(ns_status);
-
-    tfm_mailbox_hal_exit_critical();
-
-    /* Check if NSPE mailbox did assert a PSA client call request */
-    if (!pend_slots) {
-        return MAILBOX_NO_PEND_EVENT;
-    }
+    SPM_ASSERT(spe_mailbox_queue.ns_slots != NULL);
 
     for (idx = 0; idx < spe_mailbox_queue.ns_slot_count; idx++) {
-        mask_bits = (1 << idx);
         /* Check if current NSPE mailbox queue slot is pending for handling */
-        if (!(pend_slots & mask_bits)) {
+        if (!is_nspe_slot_pend(idx)) {
             continue;
         }
 
@@ -369,7 +422,37 @@ int32_t tfm_mailbox_handle_msg(void)
          * A more general implementation should dynamically search and
          * select an empty SPE mailbox queue slot.
          */
+
+        /*
+         * The previous message from the slot is still in process. Leave the
+         * new request pending until it is replied.
+         */
+        if (!get_spe_queue_empty_status(idx)) {
+            continue;
+        }
+
+        /*
+         * Mark the slot in process together with its batch ID, so that the
+         * messages of a batch still to be dispatched are counted as
+         * outstanding when another one is replied.
+         */
+        spe_mailbox_queue.queue[idx].req_seq = consume_nspe_slot_req(idx);
+        batch_ids[idx] = spe_mailbox_queue.ns_slots[idx].msg.batch_id;
+        spe_mailbox_queue.queue[idx].batch_id = batch_ids[idx];
         clear_spe_queue_empty_status(idx);
+        pend_slots |= (1 << idx);
+    }
+
+    /* Check if NSPE mailbox did assert a PSA client call request */
+    if (!pend_slots) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    for (idx = 0; idx < spe_mailbox_queue.ns_slot_count; idx++) {
+        if (!(pend_slots & (1 << idx))) {
+            continue;
+        }
+
         spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
 
         msg_ptr = &spe_mailbox_queue.queue[idx].msg;
@@ -383,24 +466,26 @@ int32_t tfm_mailbox_handle_msg(void)
         get_spe_mailbox_msg_handle(idx,
                                    &spe_mailbox_queue.queue[idx].msg_handle);
 
-        if (tfm_mailbox_dispatch(msg_ptr, idx, &reply_slots) != MAILBOX_SUCCESS) {
+        if (tfm_mailbox_dispatch(msg_ptr, idx) != MAILBOX_SUCCESS) {
             mailbox_clean_queue_slot(idx);
             continue;
         }
-    }
-
-    tfm_mailbox_hal_enter_critical();
-
-    /* Clean the NSPE mailbox pending status. */
-    clear_nspe_queue_pend_status(ns_status, pend_slots);
 
-    /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_status, reply_slots);
-
-    tfm_mailbox_hal_exit_critical();
+        if (get_spe_queue_empty_status(idx)) {
+            replied_slots |= (1 << idx);
+        }
+    }
 
-    if (reply_slots) {
-        tfm_mailbox_hal_notify_peer();
+    /*
+     * Notify NSPE once for the messages replied synchronously, unless all of
+     * them belong to batches with other messages still in process. Those
+     * batches are notified when their last message is replied.
+     */
+    for (idx = 0; idx < spe_mailbox_queue.ns_slot_count; idx++) {
+        if ((replied_slots & (1 << idx)) && is_batch_replied(batch_ids[idx])) {
+            tfm_mailbox_hal_notify_peer();
+            break;
+        }
     }
 
     return MAILBOX_SUCCESS;
@@ -410,9 +495,7 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
 {
     uint8_t idx;
     int32_t ret;
-    struct mailbox_status_t *ns_status = spe_mailbox_queue.ns_status;
-
-    SPM_ASSERT(ns_status != NULL);
+    uint32_t batch_id;
 
     /*
      * If handle == MAILBOX_MSG_NULL_HANDLE, reply to the mailbox message
@@ -433,16 +516,14 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
         return MAILBOX_NO_PEND_EVENT;
     }
 
-    mailbox_direct_reply(idx, (uint32_t)reply);
-
-    tfm_mailbox_hal_enter_critical();
+    batch_id = spe_mailbox_queue.queue[idx].batch_id;
 
-    /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_status, (1 << idx));
-
-    tfm_mailbox_hal_exit_critical();
+    mailbox_direct_reply(idx, (uint32_t)reply);
 
-    tfm_mailbox_hal_notify_peer();
+    /* Notify NSPE when the last message in the batch is replied */
+    if (is_batch_replied(batch_id)) {
+        tfm_mailbox_hal_notify_peer();
+    }
 
     return MAILBOX_SUCCESS;
 }
@@ -475,6 +556,7 @@ static const struct tfm_rpc_ops_t mailbox_rpc_ops = {
 static int32_t tfm_mailbox_init(void)
 {
     int32_t ret;
+    uint8_t idx;
 
     spm_memset(&spe_mailbox_queue, 0, sizeof(spe_mailbox_queue));
 
@@ -501,6 +583,26 @@ static int32_t tfm_mailbox_init(void)
         return ret;
     }
 
+    /* Requests submitted before initialization are not handled */
+    for (idx = 0; idx < spe_mailbox_queue.ns_slot_count; idx++) {
+        spe_mailbox_queue.ns_req_seq[idx] =
+                                    spe_mailbox_queue.ns_slots[idx].req_seq;
+    }
+
+    /*
+     * Validate the optional NS shared memory region for payloads once, so that
+     * vectors inside it can skip the memory checks of each PSA client call.
+     */
+    if ((spe_mailbox_queue.ns_shm_size != 0) &&
+        (tfm_has_access_to_region(spe_mailbox_queue.ns_shm_base,
+                                  spe_mailbox_queue.ns_shm_size,
+                                  MEM_CHECK_NONSECURE |
+                                  MEM_CHECK_MPU_READWRITE) != SPM_SUCCESS)) {
+        tfm_rpc_unregister_ops();
+
+        return MAILBOX_INIT_ERROR;
+    }
+
     return MAILBOX_SUCCESS;
 }
 
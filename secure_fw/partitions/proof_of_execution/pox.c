@@ -1,5 +1,6 @@
 #include "psa_manifest/tfm_pox.h"
 #include "pox_handler.h"
+#include "pox_trace.h"
 #include "psa/service.h"
 #include "tfm_sp_log.h" // TF-M Secure Partition Logging
 
@@ -13,24 +14,27 @@ void pox_ipc_entry(void)
     while (1)
     {
         signals = psa_wait(PSA_WAIT_ANY, PSA_BLOCK);
-        LOG_INFFMT("[Secure] Received signal: 0x%X\n", signals);
-        
+        POX_TRACE_DBG(POX_TRACE_SIGNAL, signals, 0);
+
         if (signals & TFM_POX_SERVICE_SIGNAL)
         {
             psa_msg_t msg;
             psa_status_t status = psa_get(TFM_POX_SERVICE_SIGNAL, &msg);
             if (status != PSA_SUCCESS)
             {
-                printf("[Secure] ERROR: psa_get() failed with status: %d\n", status);
+                LOG_ERRFMT("[Secure] ERROR: psa_get() failed with status: %d\n", status);
                 psa_panic();
             }
 
             // Handle the received message with the PoX handler
             pox_ipc_handler(&msg);
+
+            // Output the events of the request once the client got its reply
+            pox_trace_flush();
         }
         else
         {
-            printf("[Secure] ERROR: Unexpected signal received (0x%X)\n", signals);
+            LOG_ERRFMT("[Secure] ERROR: Unexpected signal received (0x%X)\n", signals);
             psa_panic();
         }
     }
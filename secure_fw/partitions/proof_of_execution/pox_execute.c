@@ -1,5 +1,6 @@
 #include "pox_execute.h"
-#include "tfm_sp_log.h" // TF-M Secure Partition Logging
+#include "pox_trace.h"
+#include <stdbool.h>
 #include <stdint.h>
 
 // Define the function pointer type for non-secure functions
@@ -11,10 +12,19 @@ int pox_execute(uintptr_t faddr)
     ns_function_ptr_t ns_func = (ns_function_ptr_t)faddr;
     if (!ns_func)
     {
-        LOG_ERRFMT("[Secure] ERROR: Invalid function address.\n");
+        POX_TRACE_ERR(POX_TRACE_NULL_FADDR, 0, 0);
         return -1;
     }
 
     // Execute and return the output
     return ns_func();
 }
+
+// Weak so that platforms can provide a cycle or tick counter
+__attribute__((weak)) bool pox_get_timestamp(uint32_t *timestamp)
+{
+    (void)timestamp;
+
+    return false;
+}
+
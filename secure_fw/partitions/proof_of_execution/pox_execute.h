@@ -1,6 +1,7 @@
 #ifndef POX_EXECUTE_H
 #define POX_EXECUTE_H
 #include "tfm_sp_log.h" // TF-M Secure Partition Logging
+#include <stdbool.h>
 #include <stdint.h>
 
 typedef int (*ns_function_ptr_t)(void) __attribute__((cmse_nonsecure_call));
@@ -12,4 +13,16 @@ typedef int (*ns_function_ptr_t)(void) __attribute__((cmse_nonsecure_call));
  */
 int pox_execute(uintptr_t faddr);
 
+/**
+ * @brief Get a timestamp used to measure the time taken by executions.
+ *
+ * The default implementation has no timer, platforms can override it with a
+ * cycle or tick counter.
+ *
+ * @param timestamp    Current value of the counter
+ * @return true if the platform provides a counter, false otherwise. The time
+ *         taken by executions is then not attested.
+ */
+bool pox_get_timestamp(uint32_t *timestamp);
+
 #endif // POX_EXECUTE_H
@@ -1,78 +1,214 @@
+#include "config_tfm.h"
+#include "psa/initial_attestation.h"
 #include "pox_handler.h"
 #include "pox_execute.h"
 #include "pox_report.h"
-#include "tfm_sp_log.h" // TF-M Secure Partition Logging
+#include "pox_trace.h"
 
 // Securely stored values
 static uint8_t stored_challenge[CHALLENGE_SIZE];
 static uintptr_t stored_faddr;
 static int execution_output;
 
-// PoX IPC Handler function
-psa_status_t pox_ipc_handler(psa_msg_t *msg)
+// Reports are kept off the stack, so that the stack size does not depend on the
+// size of the tokens
+static uint8_t report_buf[REPORT_BUF_SIZE]; // Buffer for the PoX report
+#if !POX_SINGLE_TOKEN_REPORT
+static uint8_t token_buf[TOKEN_BUF_SIZE];   // Buffer for the IA token
+#endif
+
+#if ATTEST_POX_BATCH_MAX_ENTRIES > 0
+// Handle a batched request: execute every function in sequence, then get a
+// single report signed over the results of the whole batch
+static psa_status_t pox_batch_handler(psa_msg_t *msg)
 {
     psa_status_t status;
-    size_t sys_token_sz;                 // Actual size of retrieved token
-    uint8_t token_buf[TOKEN_BUF_SIZE];   // Buffer for the IA token
-    uint8_t report_buf[REPORT_BUF_SIZE]; // Buffer for the PoX report
-    size_t report_size = REPORT_BUF_SIZE;
+    struct psa_pox_batch_req_t reqs[ATTEST_POX_BATCH_MAX_ENTRIES];
+    struct psa_pox_batch_entry_t results[ATTEST_POX_BATCH_MAX_ENTRIES];
+    size_t report_size = 0;
+    size_t report_buf_size;
+    size_t num_reqs;
+    uint32_t start;
+    uint32_t end;
+    bool timed;
+    uint32_t run;
+    size_t i;
 
-    switch (msg->type)
+    if ((msg->in_size[0] != CHALLENGE_SIZE) || (msg->in_size[1] == 0) ||
+        (msg->in_size[1] > sizeof(reqs)) || ((msg->in_size[1] % sizeof(reqs[0])) != 0) ||
+        (msg->out_size[1] == 0))
     {
-    case PSA_IPC_CONNECT:
-        psa_reply(msg->handle, PSA_SUCCESS);
-        break;
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    num_reqs = msg->in_size[1] / sizeof(reqs[0]);
 
-    case PSA_IPC_CALL:
-        LOG_INFFMT("[Secure] Received input sizes: %d, %d\n", msg->in_size[0], msg->in_size[1]);
+    if (msg->out_size[0] < num_reqs * sizeof(results[0]))
+    {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
 
-        if (msg->in_size[0] != CHALLENGE_SIZE || msg->in_size[1] != sizeof(uintptr_t))
+    // The report must fit in the client buffer, psa_write() past its end is fatal
+    report_buf_size = (msg->out_size[1] < REPORT_BUF_SIZE) ? msg->out_size[1] : REPORT_BUF_SIZE;
+
+    psa_read(msg->handle, 0, stored_challenge, CHALLENGE_SIZE);
+    psa_read(msg->handle, 1, reqs, msg->in_size[1]);
+
+    // Check the whole batch before executing any function of it
+    for (i = 0; i < num_reqs; i++)
+    {
+        if (reqs[i].repeat > POX_BATCH_MAX_REPEAT)
         {
+            POX_TRACE_ERR(POX_TRACE_INVALID_ARGS, i, reqs[i].repeat);
             return PSA_ERROR_INVALID_ARGUMENT;
         }
+    }
 
-        // Read input parameters
-        psa_read(msg->handle, 0, stored_challenge, CHALLENGE_SIZE);
-        psa_read(msg->handle, 1, &stored_faddr, sizeof(uintptr_t));
-
-        execution_output = pox_execute(stored_faddr); // Call the function from pox_execute.c
+    for (i = 0; i < num_reqs; i++)
+    {
+        results[i].faddr = reqs[i].faddr;
+        results[i].repeat = (reqs[i].repeat == 0) ? 1 : reqs[i].repeat;
 
-        // Get Initial Attestation Token
-        status = att_get_iat(stored_challenge, token_buf, &sys_token_sz);
-        LOG_INFFMT("[Secure] att_get_iat status: %d, token size: %d\n", status, (int)sys_token_sz);
-        if (status != PSA_SUCCESS)
+        timed = pox_get_timestamp(&start);
+        for (run = 0; run < results[i].repeat; run++)
         {
-            LOG_ERRFMT("[Secure] ERROR: Failed to get attestation token.\n");
-            return PSA_ERROR_GENERIC_ERROR;
+            results[i].output = pox_execute((uintptr_t)reqs[i].faddr);
         }
 
-        // Generate PoX report
-        LOG_INFFMT("[Secure] Calling generate_pox_report with token size: %d, buffer size: %d\n", 
-                  (int)sys_token_sz, (int)report_size);
-        status = generate_pox_report(token_buf, sys_token_sz, stored_faddr, execution_output, 
-                                   report_buf, &report_size);
-        LOG_INFFMT("[Secure] generate_pox_report status: %d, output size: %d\n", 
-                  status, (int)report_size);
-        
-        if (status != PSA_SUCCESS)
+        results[i].time = PSA_POX_TIME_NONE;
+        if (timed && pox_get_timestamp(&end))
         {
-            LOG_ERRFMT("[Secure] ERROR: Failed to generate PoX report.\n");
-            return PSA_ERROR_GENERIC_ERROR;
+            // PSA_POX_TIME_NONE is reserved, a time of that value saturates below it
+            results[i].time = end - start;
+            if (results[i].time == PSA_POX_TIME_NONE)
+            {
+                results[i].time--;
+            }
         }
+    }
+
+    status = psa_proof_of_execution_get_batch_token(results, num_reqs,
+                                                    stored_challenge, CHALLENGE_SIZE,
+                                                    report_buf, report_buf_size,
+                                                    &report_size);
+    POX_TRACE_INF(POX_TRACE_BATCH, status, num_reqs);
+    if (status != PSA_SUCCESS)
+    {
+        POX_TRACE_ERR(POX_TRACE_TOKEN, status, report_size);
+        return status;
+    }
+
+    // Send the results and the report covering them to Non-Secure World
+    psa_write(msg->handle, 0, results, num_reqs * sizeof(results[0]));
+    psa_write(msg->handle, 1, report_buf, report_size);
+
+    return PSA_SUCCESS;
+}
+#endif /* ATTEST_POX_BATCH_MAX_ENTRIES > 0 */
+
+// Handle a request executing a single function
+static psa_status_t pox_call_handler(psa_msg_t *msg)
+{
+    psa_status_t status;
+    uint8_t *report = report_buf;
+    size_t report_size = REPORT_BUF_SIZE;
+#if !POX_SINGLE_TOKEN_REPORT
+    size_t sys_token_sz; // Actual size of retrieved token
+#endif
 
-        // Send PoX Report to Non-Secure World
-        psa_write(msg->handle, 0, &execution_output, sizeof(int));
-        LOG_INFFMT("[Secure] Send POX Report with size %d\n", report_size);
-        psa_write(msg->handle, 1, report_buf, report_size); // Send only the PoX report
+    POX_TRACE_DBG(POX_TRACE_CALL, msg->type, msg->in_size[0] + msg->in_size[1]);
+
+    if (msg->in_size[0] != CHALLENGE_SIZE || msg->in_size[1] != sizeof(uintptr_t) ||
+        msg->out_size[0] < sizeof(int) || msg->out_size[1] == 0)
+    {
+        POX_TRACE_ERR(POX_TRACE_INVALID_ARGS, msg->in_size[0], msg->in_size[1]);
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    // The report must fit in the client buffer, psa_write() past its end is fatal
+    if (msg->out_size[1] < report_size)
+    {
+        report_size = msg->out_size[1];
+    }
+
+    // Read input parameters
+    psa_read(msg->handle, 0, stored_challenge, CHALLENGE_SIZE);
+    psa_read(msg->handle, 1, &stored_faddr, sizeof(uintptr_t));
+
+    execution_output = pox_execute(stored_faddr); // Call the function from pox_execute.c
+    POX_TRACE_INF(POX_TRACE_EXECUTED, stored_faddr, execution_output);
+
+#if POX_SINGLE_TOKEN_REPORT
+    // Get a single token signed over the nonce, the PoX and platform claims
+    status = psa_proof_of_execution_get_result_token(stored_faddr, execution_output,
+                                                     stored_challenge, CHALLENGE_SIZE,
+                                                     report, report_size,
+                                                     &report_size);
+    if (status != PSA_SUCCESS)
+    {
+        POX_TRACE_ERR(POX_TRACE_TOKEN, status, report_size);
+        return (status == PSA_ERROR_BUFFER_TOO_SMALL) ? status : PSA_ERROR_GENERIC_ERROR;
+    }
+#else
+    // Get Initial Attestation Token
+    status = att_get_iat(stored_challenge, token_buf, sizeof(token_buf), &sys_token_sz);
+    if (status != PSA_SUCCESS)
+    {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+#if PSA_FRAMEWORK_HAS_MM_IOVEC == 1
+    // Encode the report directly in the client buffer
+    report = psa_map_outvec(msg->handle, 1);
+    report_size = msg->out_size[1];
+#endif
+
+    // Generate PoX report
+    status = generate_pox_report(token_buf, sys_token_sz, stored_faddr, execution_output,
+                                 report, &report_size);
+    if (status != PSA_SUCCESS)
+    {
+        POX_TRACE_ERR(POX_TRACE_REPORT, status, report_size);
+        return status;
+    }
+#endif /* POX_SINGLE_TOKEN_REPORT */
+
+    // Send PoX Report to Non-Secure World
+    psa_write(msg->handle, 0, &execution_output, sizeof(int));
+    POX_TRACE_DBG(POX_TRACE_TOKEN, PSA_SUCCESS, report_size);
+#if (PSA_FRAMEWORK_HAS_MM_IOVEC == 1) && !POX_SINGLE_TOKEN_REPORT
+    psa_unmap_outvec(msg->handle, 1, report_size);
+#else
+    psa_write(msg->handle, 1, report, report_size); // Send only the PoX report
+#endif
+
+    return PSA_SUCCESS;
+}
+
+// PoX IPC Handler function
+psa_status_t pox_ipc_handler(psa_msg_t *msg)
+{
+    switch (msg->type)
+    {
+    case PSA_IPC_CONNECT:
         psa_reply(msg->handle, PSA_SUCCESS);
         break;
 
+    case PSA_IPC_CALL:
+        psa_reply(msg->handle, pox_call_handler(msg));
+        break;
+
+#if ATTEST_POX_BATCH_MAX_ENTRIES > 0
+    case PSA_POX_CALL_BATCH:
+        psa_reply(msg->handle, pox_batch_handler(msg));
+        break;
+#endif
+
     case PSA_IPC_DISCONNECT:
         psa_reply(msg->handle, PSA_SUCCESS);
         break;
 
     default:
-        LOG_ERRFMT("[Secure] ERROR: Invalid message type received: %d\n", msg->type);
+        POX_TRACE_ERR(POX_TRACE_INVALID_TYPE, msg->type, 0);
         psa_reply(msg->handle, PSA_ERROR_PROGRAMMER_ERROR);
     }
 
@@ -1,13 +1,23 @@
 #ifndef POX_HANDLER_H
 #define POX_HANDLER_H
 
+#include <stdint.h>
+#include "config_tfm.h"
+#include "psa/initial_attestation.h"
 #include "psa/service.h"
 
 
 // Size of the challenge in bytes (256 bits)
 #define CHALLENGE_SIZE 32
-#define TOKEN_BUF_SIZE 256
-#define REPORT_BUF_SIZE 1024
+// The largest token the attestation service creates
+#define TOKEN_BUF_SIZE PSA_INITIAL_ATTEST_MAX_TOKEN_SIZE
+#if POX_SINGLE_TOKEN_REPORT
+// The report is itself a token of the attestation service
+#define REPORT_BUF_SIZE TOKEN_BUF_SIZE
+#else
+// The report embeds the IA token, the PoX claims and its own signature
+#define REPORT_BUF_SIZE (TOKEN_BUF_SIZE + 0x100)
+#endif
 
 // Function declarations
 psa_status_t pox_ipc_handler(psa_msg_t *msg);
@@ -7,9 +7,13 @@
 #include <string.h> // For memcpy
 #include "tfm_crypto_defs.h"
 #include "tfm_attest_iat_defs.h"
+#include "pox_trace.h"
 
 #define SIGNATURE_BUFFER_SIZE 64
 
+static enum psa_attest_err_t attest_get_t_cose_algorithm(int32_t *cose_algorithm_id);
+
+#if POX_TRACE_LEVEL >= POX_TRACE_LEVEL_DEBUG
 // Structure to store formatting options
 struct sf_hex_tbl_fmt
 {
@@ -18,9 +22,8 @@ struct sf_hex_tbl_fmt
     uint32_t addr;   // Starting address
 };
 
-static enum psa_attest_err_t attest_get_t_cose_algorithm(int32_t *cose_algorithm_id);
-
-void print_hex(struct sf_hex_tbl_fmt *fmt, unsigned char *data, size_t len)
+// Synchronous hex dump, only built for debug traces
+static void print_hex(struct sf_hex_tbl_fmt *fmt, unsigned char *data, size_t len)
 {
     uint32_t idx = 0;
     uint32_t cpos = fmt->addr % 16; // Current position in the row
@@ -66,21 +69,22 @@ void print_hex(struct sf_hex_tbl_fmt *fmt, unsigned char *data, size_t len)
     }
     LOG_INFFMT("\n");
 }
+#endif /* POX_TRACE_LEVEL >= POX_TRACE_LEVEL_DEBUG */
 
-psa_status_t att_get_iat(uint8_t *challenge, uint8_t *token_buf, size_t *sys_token_sz)
+psa_status_t att_get_iat(uint8_t *challenge, uint8_t *token_buf, size_t token_buf_size,
+                         size_t *sys_token_sz)
 {
-    size_t token_buf_size = ATT_MAX_TOKEN_SIZE;
-    LOG_INFFMT("[Secure] Requesting attestation token...\n");
-
     psa_status_t status = psa_initial_attest_get_token(challenge, PSA_INITIAL_ATTEST_CHALLENGE_SIZE_32, token_buf, token_buf_size, sys_token_sz);
     if (status != PSA_SUCCESS)
     {
-        LOG_INFFMT("[Secure] ERROR: Failed to get attestation token (status: %d)\n", status);
+        POX_TRACE_ERR(POX_TRACE_IAT, status, 0);
         return status;
     }
-    LOG_INFFMT("[Secure] Attestation token size: %d\n", *sys_token_sz);
+    POX_TRACE_DBG(POX_TRACE_IAT, status, *sys_token_sz);
+#if POX_TRACE_LEVEL >= POX_TRACE_LEVEL_DEBUG
     struct sf_hex_tbl_fmt fmt = {.ascii = false, .addr_label = false, .addr = 0};
     print_hex(&fmt, token_buf, *sys_token_sz); // Only print the actual token size, not the whole buffer
+#endif
     return PSA_SUCCESS;
 }
 
@@ -88,18 +92,10 @@ psa_status_t generate_pox_report(uint8_t *token_buf, size_t token_size, uintptr_
 {
     if (!token_buf || !cbor_report || !cbor_report_len)
     {
-        LOG_ERRFMT("[Secure] ERROR: Null pointer argument in generate_pox_report.\n");
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    // Validate buffer size is sufficient
-    if (*cbor_report_len < CBOR_BUFFER_SIZE)
-    {
-        LOG_ERRFMT("[Secure] ERROR: Output buffer too small (provided: %d, required: %d).\n",
-                   *cbor_report_len, CBOR_BUFFER_SIZE);
-        return PSA_ERROR_BUFFER_TOO_SMALL;
-    }
-
+    // A too small output buffer is reported by the encoder when finishing
     enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
     struct attest_token_encode_ctx pox_ctx;
     struct q_useful_buf out_buf;
@@ -114,32 +110,23 @@ psa_status_t generate_pox_report(uint8_t *token_buf, size_t token_size, uintptr_
     // Check that the buffer is valid
     if (out_buf.ptr == NULL)
     {
-        LOG_ERRFMT("[Secure] ERROR: Output buffer pointer is NULL\n");
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
-    LOG_INFFMT("[Secure] Output buffer initialized at %p with size: %d\n",
-               out_buf.ptr, (int)out_buf.len);
-
     // Get the COSE algorithm ID for token signing
     attest_err = attest_get_t_cose_algorithm(&cose_algorithm_id);
     if (attest_err != PSA_ATTEST_ERR_SUCCESS)
     {
-        LOG_ERRFMT("[Secure] ERROR: Failed to get COSE algorithm ID: %d\n", attest_err);
+        POX_TRACE_ERR(POX_TRACE_ENCODE_ERROR, attest_err, 0);
         return attest_err;
     }
-    LOG_INFFMT("[Secure] COSE algorithm ID: %d\n", cose_algorithm_id);
-    LOG_INFFMT("[Secure] Starting CBOR encoding with key_select: %d\n", key_select);
     enum attest_token_err_t err = attest_token_encode_start(&pox_ctx,
                                                             key_select,
                                                             cose_algorithm_id,
                                                             &out_buf);
-
-    LOG_INFFMT("[Secure] CBOR encoding started\n");
-
     if (err != ATTEST_TOKEN_ERR_SUCCESS)
     {
-        LOG_ERRFMT("[PoX] Failed to start encoding: %d\n", err);
+        POX_TRACE_ERR(POX_TRACE_ENCODE_ERROR, err, 0);
         return PSA_ERROR_GENERIC_ERROR;
     }
     // // Label definitions for the PoX report
@@ -152,93 +139,41 @@ psa_status_t generate_pox_report(uint8_t *token_buf, size_t token_size, uintptr_
     token_buf_c.ptr = token_buf;
     token_buf_c.len = token_size;
 
-    LOG_INFFMT("[Secure] Adding attestation token of size: %d\n", token_size);
-
-    // Add the attestation token as a binary string
+    // Encoding errors are latched by QCBOR and reported when finishing
     attest_token_encode_add_bstr(&pox_ctx, IAT_POX_IA, &token_buf_c);
-
-    // Verify CBOR encoding state after adding attestation token
-    QCBORError cbor_error = QCBOREncode_GetErrorState(attest_token_encode_borrow_cbor_cntxt(&pox_ctx));
-    if (cbor_error != QCBOR_SUCCESS)
-    {
-        LOG_ERRFMT("[PoX] CBOR error after adding attestation token: %d\n", cbor_error);
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-    LOG_INFFMT("[Secure] Successfully added attestation token\n");
-
-    LOG_INFFMT("[Secure] Adding executable address: 0x%x\n", (unsigned int)faddr);
     attest_token_encode_add_integer(&pox_ctx, IAT_POX_FADDR, (int64_t)faddr);
-
-    // Verify CBOR encoding state after adding executable address
-    cbor_error = QCBOREncode_GetErrorState(attest_token_encode_borrow_cbor_cntxt(&pox_ctx));
-    if (cbor_error != QCBOR_SUCCESS)
-    {
-        LOG_ERRFMT("[PoX] CBOR error after adding executable address: %d\n", cbor_error);
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-    LOG_INFFMT("[Secure] Successfully added executable address\n");
-
-    LOG_INFFMT("[Secure] Adding execution result: %d\n", execution_output);
     attest_token_encode_add_integer(&pox_ctx, IAT_POX_OUT, (int64_t)execution_output);
 
-    // Verify CBOR encoding state after adding execution result
-    cbor_error = QCBOREncode_GetErrorState(attest_token_encode_borrow_cbor_cntxt(&pox_ctx));
-    if (cbor_error != QCBOR_SUCCESS)
-    {
-        LOG_ERRFMT("[PoX] CBOR error after adding execution result: %d\n", cbor_error);
-        return PSA_ERROR_GENERIC_ERROR;
-    }
-    LOG_INFFMT("[Secure] Finalizing CBOR encoding\n");
     err = attest_token_encode_finish(&pox_ctx, &final_report);
     if (err != ATTEST_TOKEN_ERR_SUCCESS)
     {
-        LOG_ERRFMT("[PoX] Failed to finish encoding: %d\n", err);
-        // Map COSE error codes to more meaningful messages
-        switch (err)
-        {
-        case ATTEST_TOKEN_ERR_TOO_SMALL:
-            LOG_ERRFMT("[PoX] Output buffer too small\n");
-            return PSA_ERROR_BUFFER_TOO_SMALL;
-        case ATTEST_TOKEN_ERR_CBOR_FORMATTING:
-            LOG_ERRFMT("[PoX] CBOR formatting error\n");
-            break;
-        case ATTEST_TOKEN_ERR_SIGNING_KEY:
-            LOG_ERRFMT("[PoX] Signing key error\n");
-            break;
-        default:
-            LOG_ERRFMT("[PoX] Generic token encoding error\n");
-            break;
-        }
-        return PSA_ERROR_GENERIC_ERROR;
+        POX_TRACE_ERR(POX_TRACE_ENCODE_ERROR, err, 0);
+        return (err == ATTEST_TOKEN_ERR_TOO_SMALL) ? PSA_ERROR_BUFFER_TOO_SMALL
+                                                   : PSA_ERROR_GENERIC_ERROR;
     }
 
     // Validate final report data
     if (final_report.ptr == NULL || final_report.len == 0)
     {
-        LOG_ERRFMT("[PoX] Final report is empty or invalid\n");
         return PSA_ERROR_GENERIC_ERROR;
     }
 
     // Check if the final report fits within the output buffer
     if (final_report.len > *cbor_report_len)
     {
-        LOG_ERRFMT("[PoX] Final report size (%d) exceeds output buffer size (%d)\n",
-                   (int)final_report.len, (int)*cbor_report_len);
         return PSA_ERROR_BUFFER_TOO_SMALL;
     }
 
     // Copy the final report data to the output buffer if they're not already the same
     if (final_report.ptr != cbor_report)
     {
-        LOG_INFFMT("[Secure] Copying %d bytes from final report to output buffer\n",
-                   (int)final_report.len);
         memcpy(cbor_report, final_report.ptr, final_report.len);
     }
 
     // Update the output size
     *cbor_report_len = final_report.len;
 
-    LOG_INFFMT("[Secure] Successfully generated PoX report of size: %d\n", (int)final_report.len);
+    POX_TRACE_INF(POX_TRACE_REPORT, PSA_SUCCESS, final_report.len);
 
     return PSA_SUCCESS;
 }
@@ -268,7 +203,6 @@ static enum psa_attest_err_t attest_get_t_cose_algorithm(
         switch (psa_get_key_bits(&attr))
         {
         case 256:
-            LOG_INFFMT("ES256\n");
             *cose_algorithm_id = T_COSE_ALGORITHM_ES256;
             break;
         case 384:
@@ -286,7 +220,6 @@ static enum psa_attest_err_t attest_get_t_cose_algorithm(
         switch (psa_get_key_bits(&attr))
         {
         case 256:
-            LOG_INFFMT("HMAC256\n");
             *cose_algorithm_id = T_COSE_ALGORITHM_HMAC256;
             break;
         case 384:
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "pox_trace.h"
+#include "tfm_sp_log.h" // TF-M Secure Partition Logging
+
+#if POX_TRACE_LEVEL > POX_TRACE_LEVEL_SILENCE
+
+#if POX_TRACE_BUF_ENTRIES == 0
+#error "POX_TRACE_BUF_ENTRIES must not be 0 when tracing is enabled!"
+#endif
+
+// Ring buffer of the recorded events, also readable with a debugger
+static struct pox_trace_entry_t trace_buf[POX_TRACE_BUF_ENTRIES];
+// Number of events recorded and flushed since boot
+static uint32_t trace_recorded;
+static uint32_t trace_flushed;
+
+void pox_trace_record(uint16_t level, uint16_t event, uint32_t arg0, uint32_t arg1)
+{
+    struct pox_trace_entry_t *entry = &trace_buf[trace_recorded % POX_TRACE_BUF_ENTRIES];
+
+    entry->level = level;
+    entry->event = event;
+    entry->arg0 = arg0;
+    entry->arg1 = arg1;
+    trace_recorded++;
+}
+
+void pox_trace_flush(void)
+{
+    struct pox_trace_entry_t *entry;
+
+    // Entries overwritten before being flushed are lost
+    if (trace_recorded - trace_flushed > POX_TRACE_BUF_ENTRIES)
+    {
+        LOG_INFFMT("[POX] %d trace events lost\n",
+                   (int)(trace_recorded - trace_flushed - POX_TRACE_BUF_ENTRIES));
+        trace_flushed = trace_recorded - POX_TRACE_BUF_ENTRIES;
+    }
+
+    while (trace_flushed != trace_recorded)
+    {
+        entry = &trace_buf[trace_flushed % POX_TRACE_BUF_ENTRIES];
+        LOG_INFFMT("[POX] L%d E%d 0x%x 0x%x\n", entry->level, entry->event,
+                   entry->arg0, entry->arg1);
+        trace_flushed++;
+    }
+}
+
+#endif /* POX_TRACE_LEVEL > POX_TRACE_LEVEL_SILENCE */
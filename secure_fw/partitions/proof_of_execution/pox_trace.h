@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef POX_TRACE_H
+#define POX_TRACE_H
+
+#include <stdint.h>
+#include "config_tfm.h"
+
+// The PoX trace levels
+#define POX_TRACE_LEVEL_DEBUG   3 // All trace events are recorded
+#define POX_TRACE_LEVEL_INFO    2 // All trace events except debug ones
+#define POX_TRACE_LEVEL_ERROR   1 // Only error events are recorded
+#define POX_TRACE_LEVEL_SILENCE 0 // Tracing is compiled out
+
+#if (POX_TRACE_LEVEL > POX_TRACE_LEVEL_DEBUG) || \
+    (POX_TRACE_LEVEL < POX_TRACE_LEVEL_SILENCE)
+#error "Incorrect POX_TRACE_LEVEL value!"
+#endif
+
+// Trace events, with the meaning of their two arguments
+enum pox_trace_event_t
+{
+    POX_TRACE_SIGNAL = 1,   // signals, 0
+    POX_TRACE_CALL,         // msg type, number of input bytes
+    POX_TRACE_INVALID_ARGS, // in_size[0], in_size[1], or batch entry, repeat
+    POX_TRACE_INVALID_TYPE, // msg type, 0
+    POX_TRACE_EXECUTED,     // function address, output
+    POX_TRACE_NULL_FADDR,   // 0, 0
+    POX_TRACE_IAT,          // status, token size
+    POX_TRACE_TOKEN,        // status, token size
+    POX_TRACE_REPORT,       // status, report size
+    POX_TRACE_ENCODE_ERROR, // attest_token_err_t, 0
+    POX_TRACE_BATCH,        // status, number of functions
+};
+
+// Entry of the trace ring buffer
+struct pox_trace_entry_t
+{
+    uint16_t level;
+    uint16_t event;
+    uint32_t arg0;
+    uint32_t arg1;
+};
+
+#if POX_TRACE_LEVEL > POX_TRACE_LEVEL_SILENCE
+/**
+ * @brief Records an event in the trace ring buffer, overwriting the oldest
+ *        entry when it is full. Nothing is output at this point.
+ *
+ * @param level   Trace level of the event
+ * @param event   Event, as in enum pox_trace_event_t
+ * @param arg0    First argument of the event
+ * @param arg1    Second argument of the event
+ */
+void pox_trace_record(uint16_t level, uint16_t event, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Outputs the events recorded since the last flush through the
+ *        partition log. Meant to be called outside of the request handling.
+ */
+void pox_trace_flush(void);
+#else
+#define pox_trace_flush()
+#endif
+
+#if POX_TRACE_LEVEL >= POX_TRACE_LEVEL_ERROR
+#define POX_TRACE_ERR(event, arg0, arg1) \
+    pox_trace_record(POX_TRACE_LEVEL_ERROR, (event), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define POX_TRACE_ERR(event, arg0, arg1)
+#endif
+
+#if POX_TRACE_LEVEL >= POX_TRACE_LEVEL_INFO
+#define POX_TRACE_INF(event, arg0, arg1) \
+    pox_trace_record(POX_TRACE_LEVEL_INFO, (event), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define POX_TRACE_INF(event, arg0, arg1)
+#endif
+
+#if POX_TRACE_LEVEL >= POX_TRACE_LEVEL_DEBUG
+#define POX_TRACE_DBG(event, arg0, arg1) \
+    pox_trace_record(POX_TRACE_LEVEL_DEBUG, (event), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define POX_TRACE_DBG(event, arg0, arg1)
+#endif
+
+#endif // POX_TRACE_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -32,4 +32,8 @@
 #error "Invalid config: ITS_VALIDATE_METADATA_FROM_FLASH shall be enabled when PS_VALIDATE_METADATA_FROM_FLASH is enabled"
 #endif
 
+#if PS_OBJ_TABLE_MERKLE_AUTH && (!defined(PS_ENCRYPTION))
+#error "Invalid config: PS_OBJ_TABLE_MERKLE_AUTH and NOT PS_ENCRYPTION!"
+#endif
+
 #endif /* __CONFIG_PARTITION_PS_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -129,6 +129,21 @@ psa_status_t ps_crypto_destroykey(void)
     return PSA_SUCCESS;
 }
 
+psa_status_t ps_crypto_hash(const uint8_t *input, size_t input_len,
+                            uint8_t *hash)
+{
+    psa_status_t status;
+    size_t out_len;
+
+    status = psa_hash_compute(PSA_ALG_SHA_256, input, input_len,
+                              hash, PS_HASH_LEN_BYTES, &out_len);
+    if (status != PSA_SUCCESS || out_len != PS_HASH_LEN_BYTES) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return PSA_SUCCESS;
+}
+
 void ps_crypto_set_iv(const union ps_crypto_t *crypto)
 {
     (void)memcpy(ps_crypto_iv_buf, crypto->ref.iv, PS_IV_LEN_BYTES);
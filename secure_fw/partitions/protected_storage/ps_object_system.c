@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include "cmsis_compiler.h"
+#include "config_tfm.h"
 #include "psa/internal_trusted_storage.h"
 #ifdef PS_ENCRYPTION
 #include "ps_encrypted_object.h"
@@ -222,18 +223,36 @@ clear_data_and_return:
     return err;
 }
 
-psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
-                              psa_storage_create_flags_t create_flags,
-                              uint32_t size)
+/**
+ * \brief Writes the new version of an object, with the data provided by the
+ *        client, to a new file. On success, g_obj_tbl_info holds the object
+ *        table information of the new file.
+ *
+ * \param[in]  uid           Unique identifier for the data
+ * \param[in]  client_id     Identifier of the asset's owner (client)
+ * \param[in]  create_flags  Flags indicating the properties of the data
+ * \param[in]  size          Size of the object data
+ * \param[out] p_old_fid     File ID of the previous version of the object, or
+ *                           PS_INVALID_FID if the object did not exist
+ *
+ * \note The caller must clear g_ps_object.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_write_new_object(psa_storage_uid_t uid,
+                                        int32_t client_id,
+                                        psa_storage_create_flags_t create_flags,
+                                        uint32_t size, uint32_t *p_old_fid)
 {
     psa_status_t err;
-    uint32_t old_fid = PS_INVALID_FID;
     uint32_t fid_am_reserved = 1;
 
 #ifndef PS_ENCRYPTION
     uint32_t wrt_size;
 #endif
 
+    *p_old_fid = PS_INVALID_FID;
+
     /* Boundary check the incoming request */
     if (size > PS_MAX_ASSET_SIZE) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -255,7 +274,7 @@ psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
         err = ps_read_object(READ_HEADER_ONLY);
 #endif
         if (err != PSA_SUCCESS) {
-            goto clear_data_and_return;
+            return err;
         }
 
         /* If the object exists and has the write once flag set, then it cannot
@@ -263,8 +282,7 @@ psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
          */
         if (g_ps_object.header.info.create_flags
             & PSA_STORAGE_FLAG_WRITE_ONCE) {
-            err = PSA_ERROR_NOT_PERMITTED;
-            goto clear_data_and_return;
+            return PSA_ERROR_NOT_PERMITTED;
         }
 
         /* Update the create flags and max object size */
@@ -272,7 +290,7 @@ psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
         g_ps_object.header.info.max_size = size;
 
         /* Save old file ID */
-        old_fid = g_obj_tbl_info.fid;
+        *p_old_fid = g_obj_tbl_info.fid;
     } else if (err == PSA_ERROR_DOES_NOT_EXIST) {
         /* If the object does not exist, then initialize it based on the input
          * arguments and empty content. Requests 2 FIDs to prevent exhaustion.
@@ -280,13 +298,13 @@ psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
         fid_am_reserved = 2;
         ps_init_empty_object(create_flags, size, &g_ps_object);
     } else {
-        goto clear_data_and_return;
+        return err;
     }
 
     /* Update the object data */
     err = ps_req_mngr_read_asset_data(g_ps_object.data, size);
     if (err != PSA_SUCCESS) {
-        goto clear_data_and_return;
+        return err;
     }
 
     /* Update the current object size */
@@ -296,20 +314,74 @@ psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
     err = ps_object_table_get_free_fid(fid_am_reserved,
                                        &g_obj_tbl_info.fid);
     if (err != PSA_SUCCESS) {
-        goto clear_data_and_return;
+        return err;
     }
 
 #ifdef PS_ENCRYPTION
     g_ps_object.header.crypto.ref.uid = uid;
     g_ps_object.header.crypto.ref.client_id = client_id;
 
-    err = ps_encrypted_object_write(g_obj_tbl_info.fid, &g_ps_object);
+    return ps_encrypted_object_write(g_obj_tbl_info.fid, &g_ps_object);
 #else
     wrt_size = PS_OBJECT_SIZE(g_ps_object.header.info.current_size);
 
     /* Write g_ps_object */
-    err = ps_write_object(wrt_size);
+    return ps_write_object(wrt_size);
 #endif
+}
+
+/**
+ * \brief Checks that an object exists and can be removed. On success,
+ *        g_obj_tbl_info holds the object table information of the object.
+ *
+ * \param[in] uid        Unique identifier for the data
+ * \param[in] client_id  Identifier of the asset's owner (client)
+ *
+ * \note The caller must clear g_ps_object.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_check_object_removable(psa_storage_uid_t uid,
+                                              int32_t client_id)
+{
+    psa_status_t err;
+
+    /* Retrieve the object information from the object table if the object
+     * exists.
+     */
+    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+#ifdef PS_ENCRYPTION
+    g_ps_object.header.crypto.ref.uid = uid;
+    g_ps_object.header.crypto.ref.client_id = client_id;
+
+    err = ps_encrypted_object_read(g_obj_tbl_info.fid, &g_ps_object);
+#else
+    err = ps_read_object(READ_HEADER_ONLY);
+#endif
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Check that the write once flag is not set */
+    if (g_ps_object.header.info.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_object_create(psa_storage_uid_t uid, int32_t client_id,
+                              psa_storage_create_flags_t create_flags,
+                              uint32_t size)
+{
+    psa_status_t err;
+    uint32_t old_fid;
+
+    err = ps_write_new_object(uid, client_id, create_flags, size, &old_fid);
     if (err != PSA_SUCCESS) {
         goto clear_data_and_return;
     }
@@ -494,32 +566,11 @@ psa_status_t ps_object_delete(psa_storage_uid_t uid, int32_t client_id)
 {
     psa_status_t err;
 
-    /* Retrieve the object information from the object table if the object
-     * exists.
-     */
-    err = ps_object_table_get_obj_tbl_info(uid, client_id, &g_obj_tbl_info);
-    if (err != PSA_SUCCESS) {
-        return err;
-    }
-
-#ifdef PS_ENCRYPTION
-    g_ps_object.header.crypto.ref.uid = uid;
-    g_ps_object.header.crypto.ref.client_id = client_id;
-
-    err = ps_encrypted_object_read(g_obj_tbl_info.fid, &g_ps_object);
-#else
-    err = ps_read_object(READ_HEADER_ONLY);
-#endif
+    err = ps_check_object_removable(uid, client_id);
     if (err != PSA_SUCCESS) {
         goto clear_data_and_return;
     }
 
-    /* Check that the write once flag is not set */
-    if (g_ps_object.header.info.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) {
-        err = PSA_ERROR_NOT_PERMITTED;
-        goto clear_data_and_return;
-    }
-
     /* Delete object from the table and stores the table in the persistent
      * area.
      */
@@ -539,6 +590,97 @@ clear_data_and_return:
     return err;
 }
 
+psa_status_t ps_object_batch(int32_t client_id,
+                             const struct tfm_ps_batch_op_t *ops,
+                             uint32_t num_ops)
+{
+    psa_status_t err = PSA_SUCCESS;
+    uint32_t old_fids[PS_MAX_BATCH_OPS];
+    uint32_t new_fids[PS_MAX_BATCH_OPS];
+    uint32_t num_new_fids = 0;
+    uint32_t i;
+
+    if (num_ops == 0 || num_ops > PS_MAX_BATCH_OPS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Write the new objects and stage the table changes in RAM */
+    for (i = 0; i < num_ops; i++) {
+        old_fids[i] = PS_INVALID_FID;
+
+        if (ops[i].type == TFM_PS_BATCH_OP_SET) {
+            err = ps_write_new_object(ops[i].uid, client_id,
+                                      ops[i].create_flags, ops[i].data_length,
+                                      &old_fids[i]);
+            if (err != PSA_SUCCESS) {
+                break;
+            }
+
+            new_fids[num_new_fids++] = g_obj_tbl_info.fid;
+
+            err = ps_object_table_batch_set_obj_tbl_info(ops[i].uid, client_id,
+                                                         &g_obj_tbl_info);
+        } else {
+            err = ps_check_object_removable(ops[i].uid, client_id);
+            if (err != PSA_SUCCESS) {
+                break;
+            }
+
+            err = ps_object_table_batch_delete_object(ops[i].uid, client_id);
+            if (err == PSA_SUCCESS) {
+                old_fids[i] = g_obj_tbl_info.fid;
+            }
+        }
+
+        if (err != PSA_SUCCESS) {
+            break;
+        }
+
+        /* Remove data stored in the object before the next operation */
+        (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL,
+                     PS_MAX_OBJECT_SIZE);
+    }
+
+    /* Store the table once for the whole batch */
+    if (err == PSA_SUCCESS) {
+        err = ps_object_table_batch_commit();
+    } else {
+        ps_object_table_batch_abort();
+    }
+
+    if (err != PSA_SUCCESS) {
+        /* Remove the new objects as the object table does not refer to them */
+        for (i = 0; i < num_new_fids; i++) {
+            (void)psa_its_remove(new_fids[i]);
+        }
+
+        goto clear_data_and_return;
+    }
+
+    /* Delete old object table from the persistent area */
+    err = ps_object_table_delete_old_table();
+    if (err != PSA_SUCCESS) {
+        goto clear_data_and_return;
+    }
+
+    /* Remove the replaced and removed objects */
+    for (i = 0; i < num_ops; i++) {
+        if (old_fids[i] != PS_INVALID_FID) {
+            err = psa_its_remove(old_fids[i]);
+            if (err != PSA_SUCCESS) {
+                break;
+            }
+        }
+    }
+
+clear_data_and_return:
+    /* Remove data stored in the object before leaving the function */
+    (void)memset(&g_ps_object, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_MAX_OBJECT_SIZE);
+
+    return err;
+}
+
 psa_status_t ps_system_wipe_all(void)
 {
     /* This function may get called as a corrective action
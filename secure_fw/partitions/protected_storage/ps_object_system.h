@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include "psa/protected_storage.h"
+#include "tfm_ps_defs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -78,6 +79,23 @@ psa_status_t ps_object_write(psa_storage_uid_t uid, int32_t client_id,
  */
 psa_status_t ps_object_delete(psa_storage_uid_t uid, int32_t client_id);
 
+/**
+ * \brief Applies a batch of set and remove operations on the objects of the
+ *        provided client ID, committing them with a single object table
+ *        update. Either all the operations take effect or none of them.
+ *
+ * \param[in] client_id  Identifier of the assets' owner (client)
+ * \param[in] ops        Operations to apply, in order. The data of the set
+ *                       operations is read from the client in the same order.
+ * \param[in] num_ops    Number of operations in \p ops, between 1 and
+ *                       PS_MAX_BATCH_OPS
+ *
+ * \return Returns error code specified in \ref psa_status_t
+ */
+psa_status_t ps_object_batch(int32_t client_id,
+                             const struct tfm_ps_batch_op_t *ops,
+                             uint32_t num_ops);
+
 /**
  * \brief Gets the asset information for the object with the provided UID and
  *        client ID.
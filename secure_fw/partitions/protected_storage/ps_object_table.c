@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -24,9 +24,14 @@
 /*!
  * \def PS_OBJECT_SYSTEM_VERSION
  *
- * \brief Current object system version.
+ * \brief Current object system version. Tables authenticated through a hash
+ *        tree use a different version, as their tag covers different data.
  */
+#if PS_OBJ_TABLE_MERKLE_AUTH
+#define PS_OBJECT_SYSTEM_VERSION  0x02
+#else
 #define PS_OBJECT_SYSTEM_VERSION  0x01
+#endif
 
 /*!
  * \struct ps_obj_table_info_t
@@ -138,6 +143,63 @@ struct ps_obj_table_ctx_t {
 /* Object table context */
 static struct ps_obj_table_ctx_t ps_obj_table_ctx;
 
+/* Number of slots in the object table index. Twice the number of entries keeps
+ * the load factor at or below 50% and guarantees an empty slot.
+ */
+#define PS_OBJ_TABLE_INDEX_SLOTS  (2 * PS_OBJ_TABLE_ENTRIES)
+
+/*!
+ * \struct ps_obj_table_index_t
+ *
+ * \brief Lookup structure over the entries of the active object table, kept in
+ *        line with ps_obj_table_ctx.obj_table.obj_db.
+ */
+struct ps_obj_table_index_t {
+    uint16_t slots[PS_OBJ_TABLE_INDEX_SLOTS]; /*!< Open addressing hash table
+                                               *   of entry index + 1, keyed
+                                               *   by (uid, client_id). 0
+                                               *   means empty.
+                                               */
+    uint32_t used[(PS_OBJ_TABLE_ENTRIES + 31) / 32]; /*!< Bitmap of entries in
+                                                      *   use
+                                                      */
+    uint32_t reserved[(PS_OBJ_TABLE_ENTRIES + 31) / 32]; /*!< Bitmap of
+                                                          *   entries emptied
+                                                          *   by the pending
+                                                          *   batch, whose
+                                                          *   file cannot be
+                                                          *   reused before
+                                                          *   the batch ends
+                                                          */
+    uint32_t num_free;                        /*!< Number of free entries */
+};
+
+/* Object table index */
+static struct ps_obj_table_index_t ps_obj_table_index;
+
+/* Maximum number of entry changes in a batch: a set operation changes up to two
+ * entries (the new entry and the replaced one), a remove operation one.
+ */
+#define PS_OBJ_TABLE_BATCH_MAX_CHANGES  (2 * PS_MAX_BATCH_OPS)
+
+/*!
+ * \struct ps_obj_table_batch_t
+ *
+ * \brief Undo log of the entries changed in RAM by the pending batch.
+ */
+struct ps_obj_table_batch_t {
+    uint32_t num_changes;                     /*!< Number of logged changes */
+    struct {
+        uint32_t idx;                         /*!< Entry index */
+        struct ps_obj_table_entry_t entry;    /*!< Entry content before the
+                                               *   change
+                                               */
+    } changes[PS_OBJ_TABLE_BATCH_MAX_CHANGES];
+};
+
+/* Pending batch */
+static struct ps_obj_table_batch_t ps_obj_table_batch;
+
 /* Object table size */
 #define PS_OBJ_TABLE_SIZE            sizeof(struct ps_obj_table_t)
 
@@ -154,9 +216,25 @@ static struct ps_obj_table_ctx_t ps_obj_table_ctx;
 #define PS_CRYPTO_ASSOCIATED_DATA(crypto) ((uint8_t *)crypto + \
                                             PS_NON_AUTH_OBJ_TABLE_SIZE)
 
+#if PS_OBJ_TABLE_MERKLE_AUTH
+/* Size of the table header fields covered by the authentication tag */
+#define PS_OBJ_TABLE_HEADER_AUTH_SIZE (offsetof(struct ps_obj_table_t, obj_db) - \
+                                       PS_NON_AUTH_OBJ_TABLE_SIZE)
+
+/* The table entries are authenticated through the root of the hash tree, so
+ * the authenticated data is the header followed by the root hash.
+ */
+#define PS_OBJ_TABLE_TREE_AUTH_DATA_SIZE (PS_OBJ_TABLE_HEADER_AUTH_SIZE + \
+                                          PS_HASH_LEN_BYTES)
+#endif /* PS_OBJ_TABLE_MERKLE_AUTH */
+
 #if PS_ROLLBACK_PROTECTION
+#if PS_OBJ_TABLE_MERKLE_AUTH
+#define PS_OBJ_TABLE_AUTH_DATA_SIZE PS_OBJ_TABLE_TREE_AUTH_DATA_SIZE
+#else
 #define PS_OBJ_TABLE_AUTH_DATA_SIZE (PS_OBJ_TABLE_SIZE - \
                                      PS_NON_AUTH_OBJ_TABLE_SIZE)
+#endif /* PS_OBJ_TABLE_MERKLE_AUTH */
 
 struct ps_crypto_assoc_data_t {
     uint8_t  obj_table_data[PS_OBJ_TABLE_AUTH_DATA_SIZE];
@@ -165,6 +243,10 @@ struct ps_crypto_assoc_data_t {
 
 #define PS_CRYPTO_ASSOCIATED_DATA_LEN  sizeof(struct ps_crypto_assoc_data_t)
 
+#elif PS_OBJ_TABLE_MERKLE_AUTH
+
+#define PS_CRYPTO_ASSOCIATED_DATA_LEN PS_OBJ_TABLE_TREE_AUTH_DATA_SIZE
+
 #else
 
 /* The associated data is the header, minus the the tag data */
@@ -184,6 +266,201 @@ struct ps_crypto_assoc_data_t {
 PS_UTILS_BOUND_CHECK(OBJ_TABLE_NOT_FIT_IN_STATIC_OBJ_DATA_BUF,
                      PS_OBJ_TABLE_SIZE, PS_MAX_ASSET_SIZE);
 
+#if PS_OBJ_TABLE_MERKLE_AUTH
+/* Number of chunks of entries, which are the leaves of the hash tree */
+#define PS_OBJ_TABLE_NUM_CHUNKS ((PS_OBJ_TABLE_ENTRIES + \
+                                  PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES - 1) / \
+                                 PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES)
+
+/* Number of hash tree nodes. Node 1 is the root, node i has the children 2i
+ * and 2i + 1, and the leaves are the nodes PS_OBJ_TABLE_NUM_CHUNKS to
+ * 2 * PS_OBJ_TABLE_NUM_CHUNKS - 1. Node 0 is not used.
+ */
+#define PS_OBJ_TABLE_TREE_NODES (2 * PS_OBJ_TABLE_NUM_CHUNKS)
+
+/* Prefixes to separate the hashes of leaves and inner nodes */
+#define PS_OBJ_TABLE_TREE_LEAF_PREFIX 0x00U
+#define PS_OBJ_TABLE_TREE_NODE_PREFIX 0x01U
+
+/*!
+ * \struct ps_obj_table_tree_t
+ *
+ * \brief Hash tree over the chunks of entries of the object table. Only the
+ *        root is authenticated by the table tag, so an entry update needs to
+ *        hash its chunk and the path to the root instead of the whole table.
+ */
+struct ps_obj_table_tree_t {
+    uint8_t nodes[PS_OBJ_TABLE_TREE_NODES][PS_HASH_LEN_BYTES]; /*!< Node
+                                                                *   hashes
+                                                                */
+    uint32_t dirty[(PS_OBJ_TABLE_TREE_NODES + 31) / 32]; /*!< Bitmap of the
+                                                          *   nodes to
+                                                          *   recompute
+                                                          */
+};
+
+/* Hash tree of the object table */
+static struct ps_obj_table_tree_t ps_obj_table_tree;
+
+/**
+ * \brief Marks the chunk holding a table entry as modified.
+ *
+ * \param[in] idx  Entry index
+ */
+static void ps_table_tree_mark_entry(uint32_t idx)
+{
+    uint32_t node = PS_OBJ_TABLE_NUM_CHUNKS +
+                    (idx / PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES);
+
+    ps_obj_table_tree.dirty[node / 32] |= (1UL << (node % 32));
+}
+
+/**
+ * \brief Marks all the chunks as modified.
+ */
+static void ps_table_tree_mark_all(void)
+{
+    uint32_t node;
+
+    for (node = PS_OBJ_TABLE_NUM_CHUNKS; node < PS_OBJ_TABLE_TREE_NODES;
+         node++) {
+        ps_obj_table_tree.dirty[node / 32] |= (1UL << (node % 32));
+    }
+}
+
+/**
+ * \brief Computes the hash of a leaf of the tree.
+ *
+ * \param[in] obj_table  Object table holding the entries
+ * \param[in] node       Leaf node
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_table_tree_hash_leaf(const struct ps_obj_table_t *obj_table,
+                                            uint32_t node)
+{
+    uint8_t buf[1 + (PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES *
+                     PS_OBJECTS_TABLE_ENTRY_SIZE)];
+    uint32_t first = (node - PS_OBJ_TABLE_NUM_CHUNKS) *
+                     PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES;
+    uint32_t num = PS_UTILS_MIN(PS_OBJ_TABLE_AUTH_CHUNK_ENTRIES,
+                                PS_OBJ_TABLE_ENTRIES - first);
+
+    buf[0] = PS_OBJ_TABLE_TREE_LEAF_PREFIX;
+    (void)memcpy(&buf[1], &obj_table->obj_db[first],
+                 num * PS_OBJECTS_TABLE_ENTRY_SIZE);
+
+    return ps_crypto_hash(buf, 1 + (num * PS_OBJECTS_TABLE_ENTRY_SIZE),
+                          ps_obj_table_tree.nodes[node]);
+}
+
+/**
+ * \brief Computes the hash of an inner node of the tree from its children.
+ *
+ * \param[in] node  Inner node
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_table_tree_hash_node(uint32_t node)
+{
+    uint8_t buf[1 + (2 * PS_HASH_LEN_BYTES)];
+
+    buf[0] = PS_OBJ_TABLE_TREE_NODE_PREFIX;
+    (void)memcpy(&buf[1], ps_obj_table_tree.nodes[2 * node],
+                 2 * PS_HASH_LEN_BYTES);
+
+    return ps_crypto_hash(buf, sizeof(buf), ps_obj_table_tree.nodes[node]);
+}
+
+/**
+ * \brief Recomputes the modified chunks and their paths to the root.
+ *
+ * \param[in] obj_table  Object table the tree is built over
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_table_tree_update(const struct ps_obj_table_t *obj_table)
+{
+    psa_status_t err;
+    uint32_t node;
+
+    /* Children have higher node numbers than their parent, so walking the
+     * nodes downwards updates a node after all its modified children.
+     */
+    for (node = PS_OBJ_TABLE_TREE_NODES - 1; node >= 1; node--) {
+        if ((ps_obj_table_tree.dirty[node / 32] & (1UL << (node % 32))) == 0) {
+            continue;
+        }
+
+        if (node >= PS_OBJ_TABLE_NUM_CHUNKS) {
+            err = ps_table_tree_hash_leaf(obj_table, node);
+        } else {
+            err = ps_table_tree_hash_node(node);
+        }
+        if (err != PSA_SUCCESS) {
+            return err;
+        }
+
+        ps_obj_table_tree.dirty[node / 32] &= ~(1UL << (node % 32));
+        if (node > 1) {
+            ps_obj_table_tree.dirty[(node / 2) / 32] |=
+                                                  (1UL << ((node / 2) % 32));
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the data authenticated by the tag of an object table: its header
+ *        followed by the root of the hash tree over its entries.
+ *
+ * \param[in]  obj_table  Object table
+ * \param[out] auth_data  Buffer of PS_OBJ_TABLE_TREE_AUTH_DATA_SIZE bytes
+ *
+ * \note The tree must describe \p obj_table, apart from the chunks marked as
+ *       modified.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_table_tree_get_auth_data(
+                                        const struct ps_obj_table_t *obj_table,
+                                        uint8_t *auth_data)
+{
+    psa_status_t err;
+
+    err = ps_table_tree_update(obj_table);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    (void)memcpy(auth_data, PS_CRYPTO_ASSOCIATED_DATA(&obj_table->crypto),
+                 PS_OBJ_TABLE_HEADER_AUTH_SIZE);
+    (void)memcpy(auth_data + PS_OBJ_TABLE_HEADER_AUTH_SIZE,
+                 ps_obj_table_tree.nodes[1], PS_HASH_LEN_BYTES);
+
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Gets the authenticated data of a table read from the persistent area,
+ *        which the tree does not describe.
+ *
+ * \param[in]  obj_table  Object table
+ * \param[out] auth_data  Buffer of PS_OBJ_TABLE_TREE_AUTH_DATA_SIZE bytes
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t ps_table_tree_get_new_auth_data(
+                                        const struct ps_obj_table_t *obj_table,
+                                        uint8_t *auth_data)
+{
+    ps_table_tree_mark_all();
+
+    return ps_table_tree_get_auth_data(obj_table, auth_data);
+}
+#endif /* PS_OBJ_TABLE_MERKLE_AUTH */
+
 enum ps_obj_table_state {
     PS_OBJ_TABLE_VALID = 0,   /*!< Table content is valid */
     PS_OBJ_TABLE_INVALID,     /*!< Table content is invalid */
@@ -351,9 +628,16 @@ __STATIC_INLINE psa_status_t ps_object_table_nvc_generate_auth_tag(
     }
 
     assoc_data.nv_counter = nvc_1;
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    err = ps_table_tree_get_auth_data(obj_table, assoc_data.obj_table_data);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+#else
     (void)memcpy(assoc_data.obj_table_data,
                  PS_CRYPTO_ASSOCIATED_DATA(crypto),
                  PS_OBJ_TABLE_AUTH_DATA_SIZE);
+#endif
 
     return ps_crypto_generate_auth_tag(crypto, (const uint8_t *)&assoc_data,
                                        PS_CRYPTO_ASSOCIATED_DATA_LEN);
@@ -375,9 +659,18 @@ static void ps_object_table_authenticate(uint8_t table_idx,
 
     /* Init associated data with NVC 1 */
     assoc_data.nv_counter = init_ctx->nvc_1;
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    err = ps_table_tree_get_new_auth_data(init_ctx->p_table[table_idx],
+                                          assoc_data.obj_table_data);
+    if (err != PSA_SUCCESS) {
+        init_ctx->table_state[table_idx] = PS_OBJ_TABLE_INVALID;
+        return;
+    }
+#else
     (void)memcpy(assoc_data.obj_table_data,
                  PS_CRYPTO_ASSOCIATED_DATA(crypto),
                  PS_OBJ_TABLE_AUTH_DATA_SIZE);
+#endif
 
     err = ps_crypto_authenticate(crypto, (const uint8_t *)&assoc_data,
                                  PS_CRYPTO_ASSOCIATED_DATA_LEN);
@@ -471,6 +764,9 @@ __STATIC_INLINE psa_status_t ps_object_table_generate_auth_tag(
 {
     union ps_crypto_t *crypto = &obj_table->crypto;
     psa_status_t err;
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    uint8_t assoc_data[PS_CRYPTO_ASSOCIATED_DATA_LEN];
+#endif
 
     /* Get new IV */
     err = ps_crypto_get_iv(crypto);
@@ -478,9 +774,19 @@ __STATIC_INLINE psa_status_t ps_object_table_generate_auth_tag(
         return err;
     }
 
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    err = ps_table_tree_get_auth_data(obj_table, assoc_data);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    return ps_crypto_generate_auth_tag(crypto, assoc_data,
+                                       PS_CRYPTO_ASSOCIATED_DATA_LEN);
+#else
     return ps_crypto_generate_auth_tag(crypto,
                                        PS_CRYPTO_ASSOCIATED_DATA(crypto),
                                        PS_CRYPTO_ASSOCIATED_DATA_LEN);
+#endif
 }
 
 /**
@@ -496,12 +802,25 @@ __STATIC_INLINE void ps_object_table_authenticate_ctx_tables(
     psa_status_t err;
     union ps_crypto_t *crypto =
                                 &init_ctx->p_table[PS_OBJ_TABLE_IDX_0]->crypto;
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    uint8_t assoc_data[PS_CRYPTO_ASSOCIATED_DATA_LEN];
+#endif
 
     /* Authenticate table 0 if data is valid */
     if (init_ctx->table_state[PS_OBJ_TABLE_IDX_0] != PS_OBJ_TABLE_INVALID) {
+#if PS_OBJ_TABLE_MERKLE_AUTH
+        err = ps_table_tree_get_new_auth_data(
+                                        init_ctx->p_table[PS_OBJ_TABLE_IDX_0],
+                                        assoc_data);
+        if (err == PSA_SUCCESS) {
+            err = ps_crypto_authenticate(crypto, assoc_data,
+                                         PS_CRYPTO_ASSOCIATED_DATA_LEN);
+        }
+#else
         err = ps_crypto_authenticate(crypto,
                                      PS_CRYPTO_ASSOCIATED_DATA(crypto),
                                      PS_CRYPTO_ASSOCIATED_DATA_LEN);
+#endif
         if (err != PSA_SUCCESS) {
             init_ctx->table_state[PS_OBJ_TABLE_IDX_0] = PS_OBJ_TABLE_INVALID;
         }
@@ -511,9 +830,19 @@ __STATIC_INLINE void ps_object_table_authenticate_ctx_tables(
     if (init_ctx->table_state[PS_OBJ_TABLE_IDX_1] != PS_OBJ_TABLE_INVALID) {
         crypto = &init_ctx->p_table[PS_OBJ_TABLE_IDX_1]->crypto;
 
+#if PS_OBJ_TABLE_MERKLE_AUTH
+        err = ps_table_tree_get_new_auth_data(
+                                        init_ctx->p_table[PS_OBJ_TABLE_IDX_1],
+                                        assoc_data);
+        if (err == PSA_SUCCESS) {
+            err = ps_crypto_authenticate(crypto, assoc_data,
+                                         PS_CRYPTO_ASSOCIATED_DATA_LEN);
+        }
+#else
         err = ps_crypto_authenticate(crypto,
                                      PS_CRYPTO_ASSOCIATED_DATA(crypto),
                                      PS_CRYPTO_ASSOCIATED_DATA_LEN);
+#endif
         if (err != PSA_SUCCESS) {
             init_ctx->table_state[PS_OBJ_TABLE_IDX_1] = PS_OBJ_TABLE_INVALID;
         }
@@ -739,6 +1068,150 @@ static psa_status_t ps_set_active_object_table(
     return PSA_SUCCESS;
 }
 
+/**
+ * \brief Gets the home slot of an object in the object table index.
+ *
+ * \param[in] uid        Object UID
+ * \param[in] client_id  Client UID
+ *
+ * \return Slot number
+ */
+static uint32_t ps_table_index_home_slot(psa_storage_uid_t uid,
+                                         int32_t client_id)
+{
+    uint32_t hash;
+
+    /* Multiplicative hash of the two halves of the UID and the client ID */
+    hash = (uint32_t)uid * 0x9E3779B1U;
+    hash ^= (uint32_t)(uid >> 32);
+    hash *= 0x85EBCA77U;
+    hash ^= (uint32_t)client_id;
+    hash *= 0xC2B2AE3DU;
+    hash ^= hash >> 16;
+
+    return hash % PS_OBJ_TABLE_INDEX_SLOTS;
+}
+
+/**
+ * \brief Adds a table entry to the object table index.
+ *
+ * \param[in] idx  Entry index. The entry must hold a valid UID.
+ */
+static void ps_table_index_add(uint32_t idx)
+{
+    const struct ps_obj_table_entry_t *entry =
+                                        &ps_obj_table_ctx.obj_table.obj_db[idx];
+    uint32_t slot = ps_table_index_home_slot(entry->uid, entry->client_id);
+
+    /* There is always an empty slot as the index has more slots than entries */
+    while (ps_obj_table_index.slots[slot] != 0) {
+        slot = (slot + 1) % PS_OBJ_TABLE_INDEX_SLOTS;
+    }
+
+    ps_obj_table_index.slots[slot] = (uint16_t)(idx + 1);
+    ps_obj_table_index.used[idx / 32] |= (1UL << (idx % 32));
+
+    if ((ps_obj_table_index.reserved[idx / 32] & (1UL << (idx % 32))) != 0) {
+        /* A reserved entry is already accounted as not free */
+        ps_obj_table_index.reserved[idx / 32] &= ~(1UL << (idx % 32));
+    } else {
+        ps_obj_table_index.num_free--;
+    }
+}
+
+/**
+ * \brief Removes a table entry from the object table index, if present.
+ *
+ * \param[in] idx  Entry index. Must be called before the entry is modified.
+ */
+static void ps_table_index_remove(uint32_t idx)
+{
+    const struct ps_obj_table_entry_t *entry;
+    uint32_t hole;
+    uint32_t home;
+    uint32_t slot;
+
+    if ((ps_obj_table_index.used[idx / 32] & (1UL << (idx % 32))) == 0) {
+        return;
+    }
+
+    /* Find the slot holding the entry */
+    entry = &ps_obj_table_ctx.obj_table.obj_db[idx];
+    hole = ps_table_index_home_slot(entry->uid, entry->client_id);
+    while (ps_obj_table_index.slots[hole] != (uint16_t)(idx + 1)) {
+        hole = (hole + 1) % PS_OBJ_TABLE_INDEX_SLOTS;
+    }
+
+    /* Backward shift deletion: move following entries of the probe sequence
+     * into the hole when their home slot allows it, so that lookups never need
+     * tombstones.
+     */
+    slot = hole;
+    for (;;) {
+        slot = (slot + 1) % PS_OBJ_TABLE_INDEX_SLOTS;
+        if (ps_obj_table_index.slots[slot] == 0) {
+            break;
+        }
+
+        entry = &ps_obj_table_ctx.obj_table.obj_db[
+                                            ps_obj_table_index.slots[slot] - 1];
+        home = ps_table_index_home_slot(entry->uid, entry->client_id);
+
+        /* Skip the entry if its home slot lies cyclically in (hole, slot] */
+        if ((hole <= slot) ? ((hole < home) && (home <= slot))
+                           : ((hole < home) || (home <= slot))) {
+            continue;
+        }
+
+        ps_obj_table_index.slots[hole] = ps_obj_table_index.slots[slot];
+        hole = slot;
+    }
+    ps_obj_table_index.slots[hole] = 0;
+
+    ps_obj_table_index.used[idx / 32] &= ~(1UL << (idx % 32));
+    ps_obj_table_index.num_free++;
+}
+
+/**
+ * \brief Rebuilds the object table index from the active object table.
+ */
+static void ps_table_index_rebuild(void)
+{
+    uint32_t i;
+
+    (void)memset(&ps_obj_table_index, 0, sizeof(ps_obj_table_index));
+    ps_obj_table_index.num_free = PS_OBJ_TABLE_ENTRIES;
+
+    for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
+        if (ps_obj_table_ctx.obj_table.obj_db[i].uid != TFM_PS_INVALID_UID) {
+            ps_table_index_add(i);
+        }
+    }
+}
+
+/**
+ * \brief Copies an entry into the table, keeping the object table index in
+ *        line.
+ *
+ * \param[in] idx    Entry index
+ * \param[in] entry  Entry content to copy
+ */
+static void ps_table_set_entry(uint32_t idx,
+                               const struct ps_obj_table_entry_t *entry)
+{
+    ps_table_index_remove(idx);
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    ps_table_tree_mark_entry(idx);
+#endif
+
+    (void)memcpy(&ps_obj_table_ctx.obj_table.obj_db[idx], entry,
+                 PS_OBJECTS_TABLE_ENTRY_SIZE);
+
+    if (entry->uid != TFM_PS_INVALID_UID) {
+        ps_table_index_add(idx);
+    }
+}
+
 /**
  * \brief Gets table's entry index based on the given object UID and client ID.
  *
@@ -754,14 +1227,17 @@ static psa_status_t ps_get_object_entry_idx(psa_storage_uid_t uid,
                                             uint32_t *idx)
 {
     uint32_t i;
+    uint32_t slot = ps_table_index_home_slot(uid, client_id);
     struct ps_obj_table_t *p_table = &ps_obj_table_ctx.obj_table;
 
-    for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
+    while (ps_obj_table_index.slots[slot] != 0) {
+        i = ps_obj_table_index.slots[slot] - 1U;
         if (p_table->obj_db[i].uid == uid
             && p_table->obj_db[i].client_id == client_id) {
             *idx = i;
             return PSA_SUCCESS;
         }
+        slot = (slot + 1) % PS_OBJ_TABLE_INDEX_SLOTS;
     }
 
     return PSA_ERROR_DOES_NOT_EXIST;
@@ -776,7 +1252,8 @@ static psa_status_t ps_get_object_entry_idx(psa_storage_uid_t uid,
  *                     1 index.
  * \param[out] idx     Pointer to store the free index
  *
- * \note The table is dimensioned to fit PS_NUM_ASSETS + 1
+ * \note The table is dimensioned to fit PS_NUM_ASSETS + 1. Entries reserved
+ *       by the pending batch are not free.
  *
  * \return Returns PSA_SUCCESS and a table index if idx_num free indices are
  *         available. Otherwise, it returns PSA_ERROR_INSUFFICIENT_STORAGE.
@@ -786,26 +1263,35 @@ __STATIC_INLINE psa_status_t ps_table_free_idx(uint32_t idx_num,
                                                uint32_t *idx)
 {
     uint32_t i;
+    uint32_t busy;
     uint32_t last_free = 0;
-    struct ps_obj_table_t *p_table = &ps_obj_table_ctx.obj_table;
 
     if (idx_num == 0) {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+    if (ps_obj_table_index.num_free < idx_num) {
+        return PSA_ERROR_INSUFFICIENT_STORAGE;
+    }
+
     for (i = 0; i < PS_OBJ_TABLE_ENTRIES && idx_num > 0; i++) {
-        if (p_table->obj_db[i].uid == TFM_PS_INVALID_UID) {
+        busy = ps_obj_table_index.used[i / 32] |
+               ps_obj_table_index.reserved[i / 32];
+
+        /* Skip whole words of entries in use */
+        if (((i % 32) == 0) && (busy == UINT32_MAX)) {
+            i += 31;
+            continue;
+        }
+
+        if ((busy & (1UL << (i % 32))) == 0) {
             last_free = i;
             idx_num--;
         }
     }
 
-    if (idx_num != 0) {
-        return PSA_ERROR_INSUFFICIENT_STORAGE;
-    } else {
-        *idx = last_free;
-        return PSA_SUCCESS;
-    }
+    *idx = last_free;
+    return PSA_SUCCESS;
 }
 
 /**
@@ -816,6 +1302,11 @@ __STATIC_INLINE psa_status_t ps_table_free_idx(uint32_t idx_num,
  */
 static void ps_table_delete_entry(uint32_t idx)
 {
+    ps_table_index_remove(idx);
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    ps_table_tree_mark_entry(idx);
+#endif
+
     /* Initialise object table entry structure */
     (void)memset(&ps_obj_table_ctx.obj_table.obj_db[idx],
                  PS_DEFAULT_EMPTY_BUFF_VAL, PS_OBJECTS_TABLE_ENTRY_SIZE);
@@ -837,6 +1328,12 @@ psa_status_t ps_object_table_create(void)
 
     p_table->version = PS_OBJECT_SYSTEM_VERSION;
 
+    /* All the entries are free */
+    ps_table_index_rebuild();
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    ps_table_tree_mark_all();
+#endif
+
     /* Save object table contents */
     return ps_object_table_save_table(p_table);
 }
@@ -896,6 +1393,13 @@ psa_status_t ps_object_table_init(uint8_t *obj_data)
         return err;
     }
 
+    /* Index the entries of the active table */
+    ps_table_index_rebuild();
+#if PS_OBJ_TABLE_MERKLE_AUTH
+    /* The tree was last built over the last authenticated table */
+    ps_table_tree_mark_all();
+#endif
+
     /* Remove the old object table file */
     err = psa_its_remove(PS_TABLE_FS_ID(ps_obj_table_ctx.scratch_table));
     if (err != PSA_SUCCESS && err != PSA_ERROR_DOES_NOT_EXIST) {
@@ -964,6 +1468,7 @@ psa_status_t ps_object_table_set_obj_tbl_info(psa_storage_uid_t uid,
         .uid = TFM_PS_INVALID_UID,
         .client_id = 0,
     };
+    struct ps_obj_table_entry_t new_entry;
     struct ps_obj_table_t *p_table = &ps_obj_table_ctx.obj_table;
 
     err = ps_get_object_entry_idx(uid, client_id, &backup_idx);
@@ -979,26 +1484,27 @@ psa_status_t ps_object_table_set_obj_tbl_info(psa_storage_uid_t uid,
     }
 
     idx = PS_OBJECT_FS_ID_TO_IDX(obj_tbl_info->fid);
-    p_table->obj_db[idx].uid = uid;
-    p_table->obj_db[idx].client_id = client_id;
+    (void)memset(&new_entry, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_OBJECTS_TABLE_ENTRY_SIZE);
+    new_entry.uid = uid;
+    new_entry.client_id = client_id;
 
     /* Add new object information */
 #ifdef PS_ENCRYPTION
-    (void)memcpy(p_table->obj_db[idx].tag, obj_tbl_info->tag,
-                 PS_TAG_LEN_BYTES);
+    (void)memcpy(new_entry.tag, obj_tbl_info->tag, PS_TAG_LEN_BYTES);
 #else
-    p_table->obj_db[idx].version = obj_tbl_info->version;
+    new_entry.version = obj_tbl_info->version;
 #endif
+    ps_table_set_entry(idx, &new_entry);
 
     err = ps_object_table_save_table(p_table);
     if (err != PSA_SUCCESS) {
+        ps_table_delete_entry(idx);
+
         if (backup_entry.uid != TFM_PS_INVALID_UID) {
             /* Rollback the change in the table */
-            (void)memcpy(&p_table->obj_db[backup_idx], &backup_entry,
-                         PS_OBJECTS_TABLE_ENTRY_SIZE);
+            ps_table_set_entry(backup_idx, &backup_entry);
         }
-
-        ps_table_delete_entry(idx);
     }
 
     return err;
@@ -1058,13 +1564,146 @@ psa_status_t ps_object_table_delete_object(psa_storage_uid_t uid,
     err = ps_object_table_save_table(p_table);
     if (err != PSA_SUCCESS) {
        /* Rollback the change in the table */
-       (void)memcpy(&p_table->obj_db[backup_idx], &backup_entry,
-                    PS_OBJECTS_TABLE_ENTRY_SIZE);
+       ps_table_set_entry(backup_idx, &backup_entry);
     }
 
     return err;
 }
 
+/**
+ * \brief Logs the current content of an entry in the pending batch, so that it
+ *        can be restored if the batch is aborted.
+ *
+ * \param[in] idx  Entry index
+ */
+static void ps_table_batch_log_entry(uint32_t idx)
+{
+    uint32_t n = ps_obj_table_batch.num_changes++;
+
+    ps_obj_table_batch.changes[n].idx = idx;
+    (void)memcpy(&ps_obj_table_batch.changes[n].entry,
+                 &ps_obj_table_ctx.obj_table.obj_db[idx],
+                 PS_OBJECTS_TABLE_ENTRY_SIZE);
+}
+
+/**
+ * \brief Deletes an entry from the table as part of the pending batch. The
+ *        entry stays reserved until the batch ends, as the file it refers to
+ *        is still needed if the batch is aborted.
+ *
+ * \param[in] idx  Entry index to delete
+ */
+static void ps_table_batch_delete_entry(uint32_t idx)
+{
+    ps_table_batch_log_entry(idx);
+    ps_table_delete_entry(idx);
+
+    ps_obj_table_index.reserved[idx / 32] |= (1UL << (idx % 32));
+    ps_obj_table_index.num_free--;
+}
+
+/**
+ * \brief Releases the entries reserved by the pending batch and empties the
+ *        batch.
+ */
+static void ps_table_batch_end(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < PS_OBJ_TABLE_ENTRIES; i++) {
+        if ((ps_obj_table_index.reserved[i / 32] & (1UL << (i % 32))) != 0) {
+            ps_obj_table_index.reserved[i / 32] &= ~(1UL << (i % 32));
+            ps_obj_table_index.num_free++;
+        }
+    }
+
+    ps_obj_table_batch.num_changes = 0;
+}
+
+psa_status_t ps_object_table_batch_set_obj_tbl_info(psa_storage_uid_t uid,
+                                                    int32_t client_id,
+                                const struct ps_obj_table_info_t *obj_tbl_info)
+{
+    uint32_t idx;
+    struct ps_obj_table_entry_t new_entry;
+
+    if (ps_obj_table_batch.num_changes + 2 > PS_OBJ_TABLE_BATCH_MAX_CHANGES) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if (ps_get_object_entry_idx(uid, client_id, &idx) == PSA_SUCCESS) {
+        /* Deletes old object information */
+        ps_table_batch_delete_entry(idx);
+    }
+
+    idx = PS_OBJECT_FS_ID_TO_IDX(obj_tbl_info->fid);
+    (void)memset(&new_entry, PS_DEFAULT_EMPTY_BUFF_VAL,
+                 PS_OBJECTS_TABLE_ENTRY_SIZE);
+    new_entry.uid = uid;
+    new_entry.client_id = client_id;
+
+    /* Add new object information */
+#ifdef PS_ENCRYPTION
+    (void)memcpy(new_entry.tag, obj_tbl_info->tag, PS_TAG_LEN_BYTES);
+#else
+    new_entry.version = obj_tbl_info->version;
+#endif
+    ps_table_batch_log_entry(idx);
+    ps_table_set_entry(idx, &new_entry);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_object_table_batch_delete_object(psa_storage_uid_t uid,
+                                                 int32_t client_id)
+{
+    psa_status_t err;
+    uint32_t idx;
+
+    if (ps_obj_table_batch.num_changes + 1 > PS_OBJ_TABLE_BATCH_MAX_CHANGES) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    err = ps_get_object_entry_idx(uid, client_id, &idx);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    ps_table_batch_delete_entry(idx);
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t ps_object_table_batch_commit(void)
+{
+    psa_status_t err;
+
+    err = ps_object_table_save_table(&ps_obj_table_ctx.obj_table);
+    if (err != PSA_SUCCESS) {
+        /* Rollback the changes in the table */
+        ps_object_table_batch_abort();
+        return err;
+    }
+
+    ps_table_batch_end();
+
+    return PSA_SUCCESS;
+}
+
+void ps_object_table_batch_abort(void)
+{
+    uint32_t n = ps_obj_table_batch.num_changes;
+
+    /* Restore the entries in the reverse order of the changes */
+    while (n > 0) {
+        n--;
+        ps_table_set_entry(ps_obj_table_batch.changes[n].idx,
+                           &ps_obj_table_batch.changes[n].entry);
+    }
+
+    ps_table_batch_end();
+}
+
 psa_status_t ps_object_table_delete_old_table(void)
 {
     uint32_t table_id = PS_TABLE_FS_ID(ps_obj_table_ctx.scratch_table);
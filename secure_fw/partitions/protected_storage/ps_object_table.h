@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -123,6 +123,52 @@ psa_status_t ps_object_table_get_obj_tbl_info(psa_storage_uid_t uid,
 psa_status_t ps_object_table_delete_object(psa_storage_uid_t uid,
                                            int32_t client_id);
 
+/**
+ * \brief Sets object table information in the object table for the provided
+ *        UID and client ID pair, as part of the pending batch. The table is not
+ *        stored until ps_object_table_batch_commit is called.
+ *
+ * \param[in] uid           Identifier for the data.
+ * \param[in] client_id     Identifier of the asset’s owner (client)
+ * \param[in] obj_tbl_info  Pointer to the location to store object table
+ *                          information \ref ps_obj_table_info_t
+ *
+ * \note  The entry of the replaced object, if any, stays reserved until the
+ *        batch ends so that its file ID is not reused.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t ps_object_table_batch_set_obj_tbl_info(psa_storage_uid_t uid,
+                                                    int32_t client_id,
+                                const struct ps_obj_table_info_t *obj_tbl_info);
+
+/**
+ * \brief Deletes the table entry for the provided UID and client ID pair, as
+ *        part of the pending batch. The table is not stored until
+ *        ps_object_table_batch_commit is called.
+ *
+ * \param[in]  uid        Identifier for the data.
+ * \param[in]  client_id  Identifier of the asset’s owner (client)
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t ps_object_table_batch_delete_object(psa_storage_uid_t uid,
+                                                 int32_t client_id);
+
+/**
+ * \brief Stores the object table with all the changes of the pending batch in
+ *        the persistent area, and ends the batch. If the table cannot be
+ *        stored, the changes are rolled back.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t ps_object_table_batch_commit(void);
+
+/**
+ * \brief Rolls back all the changes of the pending batch and ends the batch.
+ */
+void ps_object_table_batch_abort(void);
+
 /**
  * \brief Deletes old object table from the persistent area.
  *
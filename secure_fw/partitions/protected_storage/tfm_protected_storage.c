@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -138,6 +138,41 @@ psa_status_t tfm_ps_remove(int32_t client_id, psa_storage_uid_t uid)
     return err;
 }
 
+psa_status_t tfm_ps_apply_batch(int32_t client_id,
+                                const struct tfm_ps_batch_op_t *ops,
+                                uint32_t num_ops)
+{
+    psa_status_t err;
+    uint32_t i;
+
+    /* Check all the operations before modifying any object */
+    for (i = 0; i < num_ops; i++) {
+        if (ops[i].uid == TFM_PS_INVALID_UID || ops[i].reserved != 0) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+
+        if (ops[i].type == TFM_PS_BATCH_OP_SET) {
+            if (ops[i].create_flags & ~(PSA_STORAGE_FLAG_WRITE_ONCE |
+                                        PSA_STORAGE_FLAG_NO_CONFIDENTIALITY |
+                                        PSA_STORAGE_FLAG_NO_REPLAY_PROTECTION)) {
+                return PSA_ERROR_NOT_SUPPORTED;
+            }
+        } else if (ops[i].type != TFM_PS_BATCH_OP_REMOVE ||
+                   ops[i].data_length != 0) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    err = ps_object_batch(client_id, ops, num_ops);
+
+    /* As for tfm_ps_remove, PSA_ERROR_INVALID_SIGNATURE is not returned */
+    if (err == PSA_ERROR_INVALID_SIGNATURE) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return err;
+}
+
 uint32_t tfm_ps_get_support(void)
 {
     /*
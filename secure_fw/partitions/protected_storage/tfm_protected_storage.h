@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include "psa/protected_storage.h"
+#include "tfm_ps_defs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -164,6 +165,46 @@ psa_status_t tfm_ps_get_info(int32_t client_id, psa_storage_uid_t uid,
  */
 psa_status_t tfm_ps_remove(int32_t client_id, psa_storage_uid_t uid);
 
+/**
+ * \brief Applies a batch of set and remove operations atomically.
+ *
+ * \param[in] client_id  Identifier of the assets' owner (client)
+ * \param[in] ops        Array of operations, applied in order
+ * \param[in] num_ops    Number of operations in \p ops
+ *
+ * \return A status indicating the success/failure of the operation as specified
+ *         in \ref psa_status_t
+ *
+ * \retval PSA_SUCCESS                      All the operations completed
+ *                                          successfully
+ * \retval PSA_ERROR_INVALID_ARGUMENT       The operation failed because one or
+ *                                          more of the given arguments were
+ *                                          invalid (invalid UID or operation
+ *                                          type, too many operations, etc.)
+ * \retval PSA_ERROR_NOT_SUPPORTED          The operation failed because one or
+ *                                          more of the flags provided in the
+ *                                          `create_flags` of an operation is
+ *                                          not supported or is not valid
+ * \retval PSA_ERROR_NOT_PERMITTED          The operation failed because one of
+ *                                          the objects to modify or remove was
+ *                                          created with
+ *                                          PSA_STORAGE_FLAG_WRITE_ONCE
+ * \retval PSA_ERROR_DOES_NOT_EXIST         The operation failed because an
+ *                                          object to remove was not found in
+ *                                          the storage
+ * \retval PSA_ERROR_INSUFFICIENT_STORAGE   The operation failed because there
+ *                                          was insufficient space on the
+ *                                          storage medium
+ * \retval PSA_ERROR_STORAGE_FAILURE        The operation failed because the
+ *                                          physical storage has failed (fatal
+ *                                          error)
+ * \retval PSA_ERROR_GENERIC_ERROR          The operation failed because of an
+ *                                          unspecified internal failure
+ */
+psa_status_t tfm_ps_apply_batch(int32_t client_id,
+                                const struct tfm_ps_batch_op_t *ops,
+                                uint32_t num_ops);
+
 /**
  * \brief Gets a bitmask with flags set for all of the optional features
  *        supported by the implementation.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "config_tfm.h"
 #include "psa/protected_storage.h"
 
 #include "tfm_protected_storage.h"
@@ -20,6 +21,9 @@
 
 static const psa_msg_t *p_msg;
 
+/* Operations of the batch being processed */
+static struct tfm_ps_batch_op_t batch_ops[PS_MAX_BATCH_OPS];
+
 static psa_status_t tfm_ps_set_req(const psa_msg_t *msg)
 {
     psa_storage_uid_t uid;
@@ -120,6 +124,49 @@ static psa_status_t tfm_ps_remove_req(const psa_msg_t *msg)
     return tfm_ps_remove(msg->client_id, uid);
 }
 
+static psa_status_t tfm_ps_batch_req(const psa_msg_t *msg)
+{
+    psa_status_t status;
+    size_t num = 0;
+    size_t num_ops;
+    size_t data_length = 0;
+    size_t i;
+
+    num_ops = msg->in_size[0] / sizeof(batch_ops[0]);
+    if (msg->in_size[0] % sizeof(batch_ops[0]) != 0) {
+        /* The size of the operation array is incorrect */
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (num_ops == 0 || num_ops > PS_MAX_BATCH_OPS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    num = psa_read(msg->handle, 0, batch_ops, msg->in_size[0]);
+    if (num != msg->in_size[0]) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    /* The data of the operations must fill the data buffer exactly */
+    for (i = 0; i < num_ops; i++) {
+        if (batch_ops[i].data_length > msg->in_size[1] - data_length) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        data_length += batch_ops[i].data_length;
+    }
+
+    if (data_length != msg->in_size[1]) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    status = tfm_ps_apply_batch(msg->client_id, batch_ops, (uint32_t)num_ops);
+
+    /* Remove the operations before leaving the function */
+    (void)memset(batch_ops, 0, sizeof(batch_ops));
+
+    return status;
+}
+
 static psa_status_t tfm_ps_get_support_req(const psa_msg_t *msg)
 {
     size_t out_size;
@@ -151,6 +198,8 @@ psa_status_t tfm_protected_storage_service_sfn(const psa_msg_t *msg)
         return tfm_ps_remove_req(msg);
     case TFM_PS_GET_SUPPORT:
         return tfm_ps_get_support_req(msg);
+    case TFM_PS_BATCH:
+        return tfm_ps_batch_req(msg);
     default:
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
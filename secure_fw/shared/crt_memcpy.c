@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -10,21 +10,58 @@
 void *memcpy(void *dest, const void *src, size_t n)
 {
     union composite_addr_t p_dst, p_src;
+    uint32_t w0, w1, w2, w3;
+    uint32_t shift;
 
     p_dst.uint_addr = (uintptr_t)dest;
     p_src.uint_addr = (uintptr_t)src;
 
-    /* Byte copy for unaligned address. check the last bit of address. */
-    while (n && (ADDR_WORD_UNALIGNED(p_dst.uint_addr) ||
-                 ADDR_WORD_UNALIGNED(p_src.uint_addr))) {
+    /* Byte copy until the destination address is aligned. */
+    while (n && ADDR_WORD_UNALIGNED(p_dst.uint_addr)) {
         *p_dst.p_byte++ = *p_src.p_byte++;
         n--;
     }
 
-    /* Quad byte copy for aligned address. */
-    while (n >= sizeof(uint32_t)) {
-        *(p_dst.p_word)++ = *(p_src.p_word)++;
-        n -= sizeof(uint32_t);
+    if (!ADDR_WORD_UNALIGNED(p_src.uint_addr)) {
+        /* Burst copy for aligned addresses. */
+        while (n >= BYTES_PER_BURST) {
+            w0 = p_src.p_word[0];
+            w1 = p_src.p_word[1];
+            w2 = p_src.p_word[2];
+            w3 = p_src.p_word[3];
+            p_dst.p_word[0] = w0;
+            p_dst.p_word[1] = w1;
+            p_dst.p_word[2] = w2;
+            p_dst.p_word[3] = w3;
+            p_dst.p_word += WORDS_PER_BURST;
+            p_src.p_word += WORDS_PER_BURST;
+            n -= BYTES_PER_BURST;
+        }
+
+        /* Quad byte copy for the remaining words. */
+        while (n >= sizeof(uint32_t)) {
+            *(p_dst.p_word)++ = *(p_src.p_word)++;
+            n -= sizeof(uint32_t);
+        }
+    } else if (n >= sizeof(uint32_t)) {
+        /*
+         * Quad byte copy for a source address misaligned with the destination
+         * address: read the aligned source words, which only hold bytes of the
+         * source word they are read for, and merge each pair of them.
+         */
+        shift = ADDR_WORD_UNALIGNED(p_src.uint_addr) * 8U;
+        p_src.uint_addr -= ADDR_WORD_UNALIGNED(p_src.uint_addr);
+
+        w0 = *(p_src.p_word)++;
+        while (n >= sizeof(uint32_t)) {
+            w1 = *(p_src.p_word)++;
+            *(p_dst.p_word)++ = WORD_MERGE(w0, w1, shift);
+            w0 = w1;
+            n -= sizeof(uint32_t);
+        }
+
+        /* Go back to the first source byte not copied yet. */
+        p_src.uint_addr -= sizeof(uint32_t) - (shift / 8U);
     }
 
     /* Byte copy for the remaining bytes. */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -13,14 +13,22 @@ void *memset(void *s, int c, size_t n)
     uint32_t pattern_word;
 
     p_mem.p_byte = (uint8_t *)s;
-    pattern_word = (((uint32_t)c) << 24) | (((uint32_t)c) << 16) |
-                   (((uint32_t)c) << 8) | ((uint32_t)c);
+    pattern_word = (((uint32_t)c) & 0xFFU) * 0x01010101U;
 
     while (n && ADDR_WORD_UNALIGNED(p_mem.uint_addr)) {
         *p_mem.p_byte++ = (uint8_t)c;
         n--;
     }
 
+    while (n >= BYTES_PER_BURST) {
+        p_mem.p_word[0] = pattern_word;
+        p_mem.p_word[1] = pattern_word;
+        p_mem.p_word[2] = pattern_word;
+        p_mem.p_word[3] = pattern_word;
+        p_mem.p_word += WORDS_PER_BURST;
+        n -= BYTES_PER_BURST;
+    }
+
     while (n >= sizeof(uint32_t)) {
         *p_mem.p_word++ = pattern_word;
         n -= sizeof(uint32_t);
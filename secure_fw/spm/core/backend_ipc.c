@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -391,6 +391,7 @@ psa_signal_t backend_wait_signals(struct partition_t *p_pt, psa_signal_t signals
     ret = p_pt->signals_asserted & signals;
     if (ret == (psa_signal_t)0) {
         p_pt->signals_waiting = signals;
+        thrd_set_state(&p_pt->thrd, THRD_STATE_BLOCK);
     }
 
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -411,6 +412,8 @@ psa_status_t backend_assert_signal(struct partition_t *p_pt, psa_signal_t signal
     p_pt->signals_asserted |= signal;
 
     if (p_pt->signals_asserted & p_pt->signals_waiting) {
+        /* Make the waiting thread ready, it picks up the signals when run */
+        thrd_set_state(&p_pt->thrd, THRD_STATE_RUNNABLE);
         ret = STATUS_NEED_SCHEDULE;
     }
     CRITICAL_SECTION_LEAVE(cs_signal);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -30,6 +30,7 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
     size_t     ovec_num    = PARAM_UNPACK_OUT_LEN(ctrl_param);
     struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     int32_t type = PARAM_UNPACK_TYPE(ctrl_param);
+    bool shm_vec = false;
 
     /* The request type must be zero or positive. */
     if (type < 0) {
@@ -53,12 +54,23 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
         ns_access = TFM_HAL_ACCESS_NS;
     }
 
+    /*
+     * Only a mailbox NS agent can claim that the vectors are inside the NS
+     * shared memory region it has validated during initialization.
+     */
+    if (PARAM_IS_SHM_VEC(ctrl_param)) {
+        if (!IS_NS_AGENT_MAILBOX(curr_partition->p_ldinf)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        shm_vec = true;
+    }
+
     /*
      * Read client invecs from the wrap input vector. It is a PROGRAMMER ERROR
      * if the memory reference for the wrap input vector is invalid or not
      * readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_connection_memory_check, fih_rc, p_connection,
              curr_partition->boundary, (uintptr_t)inptr,
              ivec_num * sizeof(psa_invec), TFM_HAL_ACCESS_READABLE | ns_access);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -73,7 +85,7 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
      * actual length later. It is a PROGRAMMER ERROR if the memory reference for
      * the wrap output vector is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_connection_memory_check, fih_rc, p_connection,
              curr_partition->boundary, (uintptr_t)outptr,
              ovec_num * sizeof(psa_outvec), TFM_HAL_ACCESS_READWRITE | ns_access);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -113,11 +125,13 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
      * memory reference was invalid or not readable.
      */
     for (i = 0; i < ivec_num; i++) {
-        FIH_CALL(tfm_hal_memory_check, fih_rc,
-                 curr_partition->boundary, (uintptr_t)ivecs_local[i].base,
-                 ivecs_local[i].len, TFM_HAL_ACCESS_READABLE | ns_access);
-        if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
-            return PSA_ERROR_PROGRAMMER_ERROR;
+        if (!shm_vec) {
+            FIH_CALL(spm_connection_memory_check, fih_rc, p_connection,
+                     curr_partition->boundary, (uintptr_t)ivecs_local[i].base,
+                     ivecs_local[i].len, TFM_HAL_ACCESS_READABLE | ns_access);
+            if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+                return PSA_ERROR_PROGRAMMER_ERROR;
+            }
         }
 
         p_connection->msg.in_size[i]    = ivecs_local[i].len;
@@ -136,11 +150,13 @@ psa_status_t spm_associate_call_params(struct connection_t *p_connection,
      * payload memory reference was invalid or not read-write.
      */
     for (i = 0; i < ovec_num; i++) {
-        FIH_CALL(tfm_hal_memory_check, fih_rc,
-                 curr_partition->boundary, (uintptr_t)ovecs_local[i].base,
-                 ovecs_local[i].len, TFM_HAL_ACCESS_READWRITE | ns_access);
-        if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
-            return PSA_ERROR_PROGRAMMER_ERROR;
+        if (!shm_vec) {
+            FIH_CALL(spm_connection_memory_check, fih_rc, p_connection,
+                     curr_partition->boundary, (uintptr_t)ovecs_local[i].base,
+                     ovecs_local[i].len, TFM_HAL_ACCESS_READWRITE | ns_access);
+            if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+                return PSA_ERROR_PROGRAMMER_ERROR;
+            }
         }
 
         p_connection->msg.out_size[i]   = ovecs_local[i].len;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022-2023 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -65,7 +65,7 @@ size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
      * Copy the client data to the service buffer. It is a fatal error
      * if the memory reference for buffer is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_connection_memory_check, fih_rc, handle,
              curr_partition->boundary, (uintptr_t)buffer,
              num_bytes, TFM_HAL_ACCESS_READWRITE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -198,7 +198,7 @@ psa_status_t tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outve
      * Copy the service buffer to client outvecs. It is a fatal error
      * if the memory reference for buffer is invalid or not readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_connection_memory_check, fih_rc, handle,
              curr_partition->boundary, (uintptr_t)buffer,
              num_bytes, TFM_HAL_ACCESS_READABLE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
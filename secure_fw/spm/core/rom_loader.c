@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -129,16 +129,19 @@ struct partition_t *load_a_partition_assuredly(struct partition_head_t *head)
 }
 
 uint32_t load_services_assuredly(struct partition_t *p_partition,
-                                 struct service_head_t *services_listhead,
+                                 struct service_t **sorted_services_tbl,
+                                 size_t sorted_tbl_size,
                                  struct service_t **stateless_services_ref_tbl,
                                  size_t ref_tbl_size)
 {
-    uint32_t i, serv_ldflags, hidx, service_setting = 0;
+    uint32_t i, serv_ldflags, hidx, sidx, service_setting = 0;
     struct service_t *services;
     const struct partition_load_info_t *p_ptldinf;
     const struct service_load_info_t *p_servldinf;
 
-    if (!p_partition || !services_listhead) {
+    if (!p_partition || !sorted_services_tbl ||
+        (sorted_tbl_size <
+         CONFIG_TFM_SERVICE_NUM * sizeof(struct service_t *))) {
         tfm_core_panic();
     }
 
@@ -153,7 +156,6 @@ uint32_t load_services_assuredly(struct partition_t *p_partition,
     for (i = 0; i < p_ptldinf->nservices && services; i++) {
         services[i].p_ldinf = &p_servldinf[i];
         services[i].partition = p_partition;
-        services[i].next = NULL;
 
         BACKEND_SERVICE_SET(service_setting, &p_servldinf[i]);
 
@@ -176,7 +178,13 @@ uint32_t load_services_assuredly(struct partition_t *p_partition,
             stateless_services_ref_tbl[hidx] = &services[i];
         }
 
-        UNI_LIST_INSERT_AFTER(services_listhead, &services[i], next);
+        /* Populate the SID-sorted service table */
+        sidx = SERVICE_GET_SID_INDEX(serv_ldflags);
+
+        if ((sidx >= CONFIG_TFM_SERVICE_NUM) || sorted_services_tbl[sidx]) {
+            tfm_core_panic();
+        }
+        sorted_services_tbl[sidx] = &services[i];
     }
 
     return service_setting;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -16,9 +16,11 @@
 #include "config_impl.h"
 #include "config_spm.h"
 #include "current.h"
+#include "fih.h"
 #include "tfm_arch.h"
 #include "lists.h"
 #include "runtime_defs.h"
+#include "tfm_hal_defs.h"
 #include "thread.h"
 #include "psa/service.h"
 #include "load/partition_defs.h"
@@ -74,6 +76,22 @@ enum connection_status {
 /* Checks if the provided client ID is a non-secure client ID */
 #define TFM_CLIENT_ID_IS_NS(client_id)        ((client_id) < 0)
 
+#if CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES > 0
+/* A secure memory range which passed tfm_hal_memory_check() */
+struct mem_check_range_t {
+    uintptr_t boundary;                      /* Boundary checked against       */
+    uintptr_t base;                          /* Base address of the range      */
+    size_t    size;                          /* Size of the range, 0 if unused */
+    uint32_t  access_type;                   /* Access type checked for        */
+};
+
+/* Per-connection cache of validated memory ranges */
+struct mem_check_cache_t {
+    struct mem_check_range_t ranges[CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES];
+    uint32_t next;                           /* Range replaced next            */
+};
+#endif
+
 /* RoT connection handle list */
 struct connection_t {
     enum connection_status status;
@@ -95,6 +113,9 @@ struct connection_t {
 #if PSA_FRAMEWORK_HAS_MM_IOVEC
     uint32_t iovec_status;                   /* MM-IOVEC status                */
 #endif
+#if CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES > 0
+    struct mem_check_cache_t mem_check_cache; /* Validated memory ranges       */
+#endif
 #if CONFIG_TFM_SPM_BACKEND_IPC == 1
     struct connection_t *p_reqs;             /* Request handle(s) link         */
     struct connection_t *p_replied;          /* Replied Handle(s) link         */
@@ -125,7 +146,6 @@ struct partition_t {
 struct service_t {
     const struct service_load_info_t *p_ldinf;     /* Service load info      */
     struct partition_t *partition;                 /* Owner of the service   */
-    struct service_t *next;                        /* For list operation     */
 };
 
 /**
@@ -250,6 +270,29 @@ void spm_init_idle_connection(struct connection_t *p_connection,
                               const struct service_t *service,
                               int32_t client_id);
 
+/**
+ * \brief                   Check a memory range with tfm_hal_memory_check(),
+ *                          using the validated ranges cached in a connection.
+ *
+ * \param[in] p_connection  The connection the range is checked for.
+ * \param[in] boundary      The boundary the range is checked against.
+ * \param[in] base          The base address of the range.
+ * \param[in] size          The size of the range.
+ * \param[in] access_type   The memory access types to check.
+ *
+ * \return                  The same values as tfm_hal_memory_check().
+ *
+ * \note                    Only secure ranges are cached. The cache is keyed
+ *                          on the boundary and cleared when the connection is
+ *                          initialized. Without
+ *                          CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES every call
+ *                          goes to tfm_hal_memory_check().
+ */
+FIH_RET_TYPE(enum tfm_hal_status_t) spm_connection_memory_check(
+                                        struct connection_t *p_connection,
+                                        uintptr_t boundary, uintptr_t base,
+                                        size_t size, uint32_t access_type);
+
 /*
  * Update connection content with information extracted from control param,
  * including message type and information of IO vectors if any.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2021-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -43,7 +43,13 @@
 #include "private/assert.h"
 
 /* Partition and service runtime data list head/runtime data table */
-static struct service_head_t services_listhead;
+/*
+ * All services sorted by SID. The manifest tool assigns each service its index
+ * in this table. Keep at least one entry for builds without any service.
+ */
+#define SORTED_SERVICES_TBL_SIZE                                  \
+    ((CONFIG_TFM_SERVICE_NUM > 0) ? CONFIG_TFM_SERVICE_NUM : 1)
+static struct service_t *sorted_services_tbl[SORTED_SERVICES_TBL_SIZE];
 struct service_t *stateless_services_ref_tbl[STATIC_HANDLE_NUM_LIMIT];
 
 /* Partition management functions */
@@ -112,12 +118,20 @@ struct connection_t *spm_get_handle_by_signal(struct partition_t *p_ptn,
 
 const struct service_t *tfm_spm_get_service_by_sid(uint32_t sid)
 {
-    struct service_t *p_prev, *p_curr;
-
-    UNI_LIST_FOREACH_NODE_PREV(p_prev, p_curr, &services_listhead, next) {
-        if (p_curr->p_ldinf->sid == sid) {
-            UNI_LIST_MOVE_AFTER(&services_listhead, p_prev, p_curr, next);
-            return p_curr;
+    uint32_t low = 0, high = CONFIG_TFM_SERVICE_NUM, mid;
+    const struct service_t *p_service;
+
+    /* Binary search, the table is sorted by SID at build time */
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        p_service = sorted_services_tbl[mid];
+
+        if (p_service->p_ldinf->sid == sid) {
+            return p_service;
+        } else if (p_service->p_ldinf->sid < sid) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
 
@@ -344,6 +358,61 @@ void spm_init_idle_connection(struct connection_t *p_connection,
 #ifdef TFM_PARTITION_NS_AGENT_MAILBOX
     p_connection->client_data = NULL;
 #endif
+
+#if CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES > 0
+    spm_memset(&p_connection->mem_check_cache, 0,
+               sizeof(p_connection->mem_check_cache));
+#endif
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) spm_connection_memory_check(
+                                        struct connection_t *p_connection,
+                                        uintptr_t boundary, uintptr_t base,
+                                        size_t size, uint32_t access_type)
+{
+    fih_int fih_rc = FIH_FAILURE;
+#if CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES > 0
+    struct mem_check_cache_t *cache = &p_connection->mem_check_cache;
+    struct mem_check_range_t *range;
+    bool cacheable;
+    uint32_t i;
+
+    /*
+     * Non-secure ranges depend on the attributes programmed by the NSPE,
+     * which may change between calls, so they are always checked.
+     */
+    cacheable = ((access_type & TFM_HAL_ACCESS_NS) == 0) && (size != 0);
+
+    if (cacheable) {
+        for (i = 0; i < CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES; i++) {
+            range = &cache->ranges[i];
+            /* A range checked for more access types covers fewer ones. */
+            if ((range->size != 0) && (range->boundary == boundary) &&
+                ((range->access_type & access_type) == access_type) &&
+                (base >= range->base) && (size <= range->size) &&
+                (base - range->base <= range->size - size)) {
+                FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+            }
+        }
+    }
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc, boundary, base, size, access_type);
+
+    if (cacheable && fih_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
+        range = &cache->ranges[cache->next];
+        range->boundary    = boundary;
+        range->base        = base;
+        range->size        = size;
+        range->access_type = access_type;
+        cache->next = (cache->next + 1) % CONFIG_TFM_SPM_MEM_CHECK_CACHE_ENTRIES;
+    }
+#else
+    (void)p_connection;
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc, boundary, base, size, access_type);
+#endif
+
+    FIH_RET(fih_rc);
 }
 
 int32_t tfm_spm_partition_get_running_partition_id(void)
@@ -396,7 +465,6 @@ uint32_t tfm_spm_init(void)
     spm_init_connection_space();
 
     UNI_LIST_INIT_NODE(PARTITION_LIST_ADDR, next);
-    UNI_LIST_INIT_NODE(&services_listhead, next);
 
     /* Init the nonsecure context. */
     tfm_nspm_ctx_init();
@@ -409,7 +477,8 @@ uint32_t tfm_spm_init(void)
 
         service_setting = load_services_assuredly(
                                 partition,
-                                &services_listhead,
+                                sorted_services_tbl,
+                                sizeof(sorted_services_tbl),
                                 stateless_services_ref_tbl,
                                 sizeof(stateless_services_ref_tbl));
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2023 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -18,13 +18,27 @@
 /* Declaration of current thread pointer. */
 struct thread_t *p_curr_thrd;
 
+/*
+ * Runnable threads are kept in ready lists, one list per group of
+ * (1 << THRD_RDY_GROUP_SHIFT) consecutive priorities, each sorted by
+ * priority. Bit (31 - group) of the ready bitmap is set while the list of the
+ * group is not empty, so the highest priority group is found by counting
+ * leading zeros.
+ */
+#define THRD_RDY_GROUP_SHIFT      3
+#define THRD_RDY_GROUP_NUM        ((THRD_PRIOR_LOWEST >> THRD_RDY_GROUP_SHIFT) + 1)
+#define THRD_RDY_GROUP(prior)     ((uint32_t)(prior) >> THRD_RDY_GROUP_SHIFT)
+#define THRD_RDY_GROUP_BIT(group) (1UL << (31U - (group)))
+
 /* Force ZERO in case ZI(bss) clear is missing. */
-static struct thread_t *p_thrd_head = NULL; /* Point to the first thread. */
-static struct thread_t *p_rnbl_head = NULL; /* Point to the first runnable. */
+static struct thread_t *rdy_heads[THRD_RDY_GROUP_NUM] = {NULL};
+static uint32_t rdy_bitmap = 0;
+/* Number of started threads, orders the threads of the same priority. */
+static uint32_t thrd_start_cnt = 0;
 
 /* Define Macro to fetch global to support future expansion (PERCPU e.g.) */
-#define LIST_HEAD   p_thrd_head
-#define RNBL_HEAD   p_rnbl_head
+#define RDY_HEADS   rdy_heads
+#define RDY_BITMAP  rdy_bitmap
 
 /* Callback function pointer for thread to query current state. */
 static thrd_query_state_t query_state_cb = (thrd_query_state_t)NULL;
@@ -34,66 +48,90 @@ void thrd_set_query_callback(thrd_query_state_t fn)
     query_state_cb = fn;
 }
 
+static void rdy_insert(struct thread_t *p_thrd)
+{
+    uint32_t group = THRD_RDY_GROUP(p_thrd->priority);
+    struct thread_t **pp_iter = &RDY_HEADS[group];
+
+    /*
+     * Threads of the same priority keep a fixed order, the last started one
+     * first, regardless of the order they become runnable in.
+     */
+    while (*pp_iter &&
+           (((*pp_iter)->priority < p_thrd->priority) ||
+            (((*pp_iter)->priority == p_thrd->priority) &&
+             ((*pp_iter)->start_seq > p_thrd->start_seq)))) {
+        pp_iter = &(*pp_iter)->next;
+    }
+
+    p_thrd->next = *pp_iter;
+    *pp_iter = p_thrd;
+    RDY_BITMAP |= THRD_RDY_GROUP_BIT(group);
+}
+
+static void rdy_remove(struct thread_t *p_thrd)
+{
+    uint32_t group = THRD_RDY_GROUP(p_thrd->priority);
+    struct thread_t **pp_iter = &RDY_HEADS[group];
+
+    while (*pp_iter && (*pp_iter != p_thrd)) {
+        pp_iter = &(*pp_iter)->next;
+    }
+
+    SPM_ASSERT(*pp_iter == p_thrd);
+
+    *pp_iter = p_thrd->next;
+    p_thrd->next = NULL;
+    if (RDY_HEADS[group] == NULL) {
+        RDY_BITMAP &= ~THRD_RDY_GROUP_BIT(group);
+    }
+}
+
 struct thread_t *thrd_next(void)
 {
-    struct thread_t *p_thrd = RNBL_HEAD;
-    uint32_t retval = 0;
+    struct thread_t *p_thrd = NULL;
+    uint32_t state, retval = 0;
     struct critical_section_t cs_signal = CRITICAL_SECTION_STATIC_INIT;
 
     CRITICAL_SECTION_ENTER(cs_signal);
     /*
-     * First runnable thread has highest priority since threads are
-     * sorted by priority.
+     * The head of the highest priority non-empty ready list is the thread to
+     * run. Its state is still queried to deliver a pending return value, and
+     * to drop it in case its signals have been withdrawn in the meantime.
      */
-    while (p_thrd) {
-        /* Change thread state if any signal changed */
-        p_thrd->state = query_state_cb(p_thrd, &retval);
+    while (RDY_BITMAP != 0) {
+        p_thrd = RDY_HEADS[__CLZ(RDY_BITMAP)];
+
+        state = query_state_cb(p_thrd, &retval);
 
-        if (p_thrd->state == THRD_STATE_RET_VAL_AVAIL) {
+        if (state == THRD_STATE_RET_VAL_AVAIL) {
             tfm_arch_set_context_ret_code(p_thrd->p_context_ctrl, retval);
-            p_thrd->state = THRD_STATE_RUNNABLE;
+            state = THRD_STATE_RUNNABLE;
         }
 
-        if (p_thrd->state == THRD_STATE_RUNNABLE) {
+        if (state == THRD_STATE_RUNNABLE) {
             break;
         }
 
-        p_thrd = p_thrd->next;
+        thrd_set_state(p_thrd, state);
+        p_thrd = NULL;
     }
     CRITICAL_SECTION_LEAVE(cs_signal);
 
     return p_thrd;
 }
 
-static void insert_by_prior(struct thread_t **head, struct thread_t *node)
-{
-    if (*head == NULL || (node->priority <= (*head)->priority)) {
-        node->next = *head;
-        *head = node;
-    } else {
-        struct thread_t *iter = *head;
-
-        while (iter->next && (node->priority > iter->next->priority)) {
-            iter = iter->next;
-        }
-
-        node->next = iter->next;
-        iter->next = node;
-    }
-}
-
 void thrd_start(struct thread_t *p_thrd, thrd_fn_t fn, thrd_fn_t exit_fn, void *param)
 {
     SPM_ASSERT(p_thrd != NULL);
     SPM_ASSERT(fn != NULL);
 
-    /* Insert a new thread with priority */
-    insert_by_prior(&LIST_HEAD, p_thrd);
+    p_thrd->start_seq = ++thrd_start_cnt;
 
     tfm_arch_init_context(p_thrd->p_context_ctrl, (uintptr_t)fn, param,
                           (uintptr_t)exit_fn);
 
-    /* Mark it as RUNNABLE after insertion */
+    /* Mark it as RUNNABLE, which inserts it into the ready list */
     thrd_set_state(p_thrd, THRD_STATE_RUNNABLE);
 }
 
@@ -101,18 +139,16 @@ void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state)
 {
     SPM_ASSERT(p_thrd != NULL);
 
-    p_thrd->state = new_state;
-
-    /*
-     * Set first runnable thread as head to reduce enumerate
-     * depth while searching for a first runnable thread.
-     */
-    if ((p_thrd->state == THRD_STATE_RUNNABLE) &&
-        ((RNBL_HEAD == NULL) || (p_thrd->priority < RNBL_HEAD->priority))) {
-        RNBL_HEAD = p_thrd;
-    } else {
-        RNBL_HEAD = LIST_HEAD;
+    /* Only RUNNABLE threads are kept in the ready lists */
+    if ((p_thrd->state != THRD_STATE_RUNNABLE) &&
+        (new_state == THRD_STATE_RUNNABLE)) {
+        rdy_insert(p_thrd);
+    } else if ((p_thrd->state == THRD_STATE_RUNNABLE) &&
+               (new_state != THRD_STATE_RUNNABLE)) {
+        rdy_remove(p_thrd);
     }
+
+    p_thrd->state = new_state;
 }
 
 uint32_t thrd_start_scheduler(struct thread_t **ppth)
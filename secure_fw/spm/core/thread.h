@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2023 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -47,7 +47,8 @@ struct thread_t {
     uint8_t                state;             /* State                             */
     uint16_t               flags;             /* Flags and align, DO NOT REMOVE!   */
     struct context_ctrl_t *p_context_ctrl;    /* Context control (sp, splimit, lr) */
-    struct thread_t       *next;              /* Next thread in list               */
+    struct thread_t       *next;              /* Next thread in ready list         */
+    uint32_t               start_seq;         /* Order among equal priorities      */
 };
 
 /* Query thread state function type */
@@ -72,6 +73,7 @@ extern struct thread_t *p_curr_thrd;
                         (p_thrd)->priority       = (uint8_t)(prio);      \
                         (p_thrd)->state          = THRD_STATE_CREATING;  \
                         (p_thrd)->flags          = 0;                    \
+                        (p_thrd)->start_seq      = 0;                    \
                         (p_thrd)->p_context_ctrl = p_ctx_ctrl;           \
                     } while (0)
 
@@ -106,16 +108,19 @@ extern struct thread_t *p_curr_thrd;
 void thrd_set_query_callback(thrd_query_state_t fn);
 
 /*
- * Set thread state, and updates the runnable head.
+ * Set thread state, and updates the ready lists.
  *
  * Parameters :
  *  p_thrd         -     Pointer of thread_t struct
  *  new_state      -     New state of thread
+ *
+ * Note :
+ *  - Caller needs to be in a critical section once scheduling has started.
  */
 void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state);
 
 /*
- * Prepare thread context with given info and insert it into schedulable list.
+ * Prepare thread context with given info and insert it into the ready lists.
  *
  * Parameters :
  *  p_thrd         -     Pointer of thread_t struct
@@ -129,7 +134,7 @@ void thrd_set_state(struct thread_t *p_thrd, uint32_t new_state);
 void thrd_start(struct thread_t *p_thrd, thrd_fn_t fn, thrd_fn_t exit_fn, void *param);
 
 /*
- * Get the next thread to run in list.
+ * Get the highest priority runnable thread to run.
  *
  * Return :
  *  Pointer of next thread to run.
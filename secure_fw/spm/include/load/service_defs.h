@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -19,6 +19,7 @@
  * bit 9: 1 - stateless, 0 - connection-based
  * bit 10: 1 - strict version policy, 0 - relaxed version policy
  * bit 11: 1 - MM-IOVEC enabled, 0 - MM-IOVEC disabled
+ * bit 23-16: index in the table of all services sorted by SID
  */
 #define SERVICE_FLAG_STATELESS_HINDEX_MASK      (0xFF)
 #define SERVICE_FLAG_NS_ACCESSIBLE              (1UL << 8)
@@ -28,6 +29,8 @@
 #define SERVICE_VERSION_POLICY_RELAXED          (0UL << 10)
 #define SERVICE_VERSION_POLICY_STRICT           (1UL << 10)
 #define SERVICE_FLAG_MM_IOVEC                   (1UL << 11)
+#define SERVICE_FLAG_SID_INDEX_POS              16
+#define SERVICE_FLAG_SID_INDEX_MASK             (0xFFUL << 16)
 
 #define SERVICE_GET_STATELESS_HINDEX(flag)      \
     ((flag) & SERVICE_FLAG_STATELESS_HINDEX_MASK)
@@ -39,6 +42,8 @@
     ((flag) & SERVICE_FLAG_VERSION_POLICY_BIT)
 #define SERVICE_ENABLED_MM_IOVEC(flag)          \
     ((flag) & SERVICE_FLAG_MM_IOVEC)
+#define SERVICE_GET_SID_INDEX(flag)             \
+    (((flag) & SERVICE_FLAG_SID_INDEX_MASK) >> SERVICE_FLAG_SID_INDEX_POS)
 
 #define STRID_TO_STRING_PTR(strid)              (const char *)(strid)
 #define STRING_PTR_TO_STRID(str)                (uintptr_t)(str)
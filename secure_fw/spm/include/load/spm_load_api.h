@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022-2024 Cypress Semiconductor Corporation (an Infineon
  * company) or an affiliate of Cypress Semiconductor Corporation. All rights
  * reserved.
@@ -52,12 +52,6 @@ struct partition_head_t {
     struct partition_t *next;           /* Next partition node  */
 };
 
-/* Runtime service struct list head node type */
-struct service_head_t {
-    uint32_t reserved;                  /* Reserved             */
-    struct service_t *next;             /* Next service node    */
-};
-
 /*
  * Load a partition object to linked list and return if a load is successful.
  * An 'assuredly' function, return NO_MORE_PARTITION for no more partitions and
@@ -67,16 +61,18 @@ struct service_head_t {
 struct partition_t *load_a_partition_assuredly(struct partition_head_t *head);
 
 /*
- * Load numbers of service objects to linked list based on given partition.
+ * Load numbers of service objects based on given partition.
  * It loads connection based services and stateless services that partition
- * contains.
+ * contains. Each service is placed into 'sorted_services_tbl' at the SID index
+ * assigned by the manifest tool, which keeps the table sorted by SID.
  * As an 'assuredly' function, errors simply panic the system and never
  * return.
  * This function returns the service signal set in a 32 bit number. Return
  * ZERO if services are not represented by signals.
  */
 uint32_t load_services_assuredly(struct partition_t *p_partition,
-                                 struct service_head_t *services_listhead,
+                                 struct service_t **sorted_services_tbl,
+                                 size_t sorted_tbl_size,
                                  struct service_t **stateless_services_ref_tbl,
                                  size_t ref_tbl_size);
 
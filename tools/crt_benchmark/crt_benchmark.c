@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host throughput benchmark of the TF-M runtime library memcpy, memmove and
+ * memset. Each routine is timed across a range of sizes and of source and
+ * destination offsets from a word boundary, next to the word-at-a-time
+ * implementation the runtime library used before the burst copies, and to
+ * the host C library. The output of every routine is checked against the C
+ * library before it is timed.
+ *
+ * Usage: crt_benchmark [min_bytes_per_case]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "crt_impl_private.h"
+
+/* Default number of bytes processed by each timed case */
+#define BENCH_DEFAULT_BYTES     (64UL * 1024UL * 1024UL)
+
+/* Largest size measured, plus room for the offsets and overlapping moves */
+#define BENCH_MAX_SIZE          4096U
+#define BENCH_BUF_SIZE          (2U * BENCH_MAX_SIZE + 64U)
+
+/* Distance between the source and destination of the overlapping moves */
+#define BENCH_MOVE_DIST         8U
+
+typedef void *(*copy_fn_t)(void *dest, const void *src, size_t n);
+typedef void *(*set_fn_t)(void *s, int c, size_t n);
+
+/* Routines built from the runtime library sources, see crt_impl.c */
+void *tfm_memcpy(void *dest, const void *src, size_t n);
+void *tfm_memmove(void *dest, const void *src, size_t n);
+void *tfm_memset(void *s, int c, size_t n);
+
+/*
+ * Word-at-a-time reference implementation, as used by the runtime library
+ * before the burst and shifted word copies. It falls back to a byte copy when
+ * the source and destination are misaligned with each other.
+ */
+static void *word_memcpy(void *dest, const void *src, size_t n)
+{
+    union composite_addr_t p_dst, p_src;
+
+    p_dst.uint_addr = (uintptr_t)dest;
+    p_src.uint_addr = (uintptr_t)src;
+
+    while (n && (ADDR_WORD_UNALIGNED(p_dst.uint_addr) ||
+                 ADDR_WORD_UNALIGNED(p_src.uint_addr))) {
+        *p_dst.p_byte++ = *p_src.p_byte++;
+        n--;
+    }
+
+    while (n >= sizeof(uint32_t)) {
+        *(p_dst.p_word)++ = *(p_src.p_word)++;
+        n -= sizeof(uint32_t);
+    }
+
+    while (n--) {
+        *p_dst.p_byte++ = *p_src.p_byte++;
+    }
+
+    return dest;
+}
+
+static void *word_memcpy_r(void *dest, const void *src, size_t n)
+{
+    union composite_addr_t p_dst, p_src;
+
+    p_dst.uint_addr = (uintptr_t)dest + n;
+    p_src.uint_addr = (uintptr_t)src  + n;
+
+    while (n && (ADDR_WORD_UNALIGNED(p_dst.uint_addr) ||
+                 ADDR_WORD_UNALIGNED(p_src.uint_addr))) {
+        *(--p_dst.p_byte) = *(--p_src.p_byte);
+        n--;
+    }
+
+    while (n >= sizeof(uint32_t)) {
+        *(--p_dst.p_word) = *(--p_src.p_word);
+        n -= sizeof(uint32_t);
+    }
+
+    while (n--) {
+        *(--p_dst.p_byte) = *(--p_src.p_byte);
+    }
+
+    return dest;
+}
+
+static void *word_memmove(void *dest, const void *src, size_t n)
+{
+    if (src >= dest) {
+        return word_memcpy(dest, src, n);
+    } else {
+        return word_memcpy_r(dest, src, n);
+    }
+}
+
+static void *word_memset(void *s, int c, size_t n)
+{
+    union composite_addr_t p_mem;
+    uint32_t pattern_word;
+
+    p_mem.p_byte = (uint8_t *)s;
+    pattern_word = (((uint32_t)c) & 0xFFU) * 0x01010101U;
+
+    while (n && ADDR_WORD_UNALIGNED(p_mem.uint_addr)) {
+        *p_mem.p_byte++ = (uint8_t)c;
+        n--;
+    }
+
+    while (n >= sizeof(uint32_t)) {
+        *p_mem.p_word++ = pattern_word;
+        n -= sizeof(uint32_t);
+    }
+
+    while (n--) {
+        *p_mem.p_byte++ = (uint8_t)c;
+    }
+
+    return s;
+}
+
+struct copy_impl_t {
+    const char *name;
+    copy_fn_t copy;
+    copy_fn_t move;
+    set_fn_t set;
+};
+
+/* Volatile so the routines are called as they would be from other units */
+static const volatile struct copy_impl_t impls[] = {
+    { "word", word_memcpy, word_memmove, word_memset },
+    { "tfm",  tfm_memcpy,  tfm_memmove,  tfm_memset  },
+    { "libc", memcpy,      memmove,      memset      },
+};
+
+#define NUM_IMPLS (sizeof(impls) / sizeof(impls[0]))
+
+static const size_t sizes[] = { 8, 16, 32, 64, 128, 256, 1024, 4096 };
+
+/* Source and destination offsets from a word boundary */
+static const struct {
+    size_t dst;
+    size_t src;
+} offsets[] = { { 0, 0 }, { 1, 1 }, { 0, 1 }, { 1, 0 }, { 0, 2 }, { 3, 1 } };
+
+enum bench_op_t {
+    BENCH_MEMCPY,
+    BENCH_MEMMOVE_FWD,
+    BENCH_MEMMOVE_BWD,
+    BENCH_MEMSET,
+};
+
+static const char *const op_names[] = {
+    "memcpy", "memmove (dst < src)", "memmove (dst > src)", "memset",
+};
+
+static uint8_t __attribute__((aligned(16))) src_buf[BENCH_BUF_SIZE];
+static uint8_t __attribute__((aligned(16))) dst_buf[BENCH_BUF_SIZE];
+static uint8_t __attribute__((aligned(16))) ref_buf[BENCH_BUF_SIZE];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static void fill_pattern(uint8_t *buf, size_t size, uint8_t seed)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        buf[i] = (uint8_t)((i * 131U) + seed);
+    }
+}
+
+/*
+ * Runs one operation on the given destination buffer. For memmove, the source
+ * and destination are in the same buffer and overlap.
+ */
+static void run_op(const volatile struct copy_impl_t *impl, enum bench_op_t op,
+                   uint8_t *buf, size_t size, size_t dst_off, size_t src_off)
+{
+    switch (op) {
+    case BENCH_MEMCPY:
+        impl->copy(buf + dst_off, src_buf + src_off, size);
+        break;
+    case BENCH_MEMMOVE_FWD:
+        impl->move(buf + dst_off, buf + BENCH_MOVE_DIST + src_off, size);
+        break;
+    case BENCH_MEMMOVE_BWD:
+        impl->move(buf + BENCH_MOVE_DIST + dst_off, buf + src_off, size);
+        break;
+    case BENCH_MEMSET:
+        impl->set(buf + dst_off, 0xA5, size);
+        break;
+    }
+}
+
+static int check_op(const volatile struct copy_impl_t *impl,
+                    enum bench_op_t op, size_t size, size_t dst_off,
+                    size_t src_off)
+{
+    fill_pattern(dst_buf, sizeof(dst_buf), 7);
+    fill_pattern(ref_buf, sizeof(ref_buf), 7);
+
+    run_op(impl, op, dst_buf, size, dst_off, src_off);
+    run_op(&impls[NUM_IMPLS - 1], op, ref_buf, size, dst_off, src_off);
+
+    return memcmp(dst_buf, ref_buf, sizeof(dst_buf));
+}
+
+static double time_op(const volatile struct copy_impl_t *impl,
+                      enum bench_op_t op, size_t size, size_t dst_off,
+                      size_t src_off, unsigned long total_bytes)
+{
+    unsigned long iters = (total_bytes / size) + 1U;
+    unsigned long i;
+    double start;
+    double elapsed;
+
+    fill_pattern(dst_buf, sizeof(dst_buf), 7);
+
+    start = now_sec();
+    for (i = 0; i < iters; i++) {
+        run_op(impl, op, dst_buf, size, dst_off, src_off);
+    }
+    elapsed = now_sec() - start;
+
+    if (elapsed <= 0.0) {
+        return 0.0;
+    }
+
+    /* Throughput in MB/s */
+    return ((double)iters * (double)size) / elapsed / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long total_bytes = BENCH_DEFAULT_BYTES;
+    size_t op, s, o, i;
+    double mbps[NUM_IMPLS];
+    int failed = 0;
+
+    if (argc > 1) {
+        total_bytes = strtoul(argv[1], NULL, 0);
+        if (total_bytes == 0) {
+            fprintf(stderr, "Usage: %s [min_bytes_per_case]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    fill_pattern(src_buf, sizeof(src_buf), 3);
+
+    for (op = BENCH_MEMCPY; op <= BENCH_MEMSET; op++) {
+        printf("\n%s, MB/s\n", op_names[op]);
+        printf("%6s %4s %4s", "size", "dst", "src");
+        for (i = 0; i < NUM_IMPLS; i++) {
+            printf(" %10s", impls[i].name);
+        }
+        printf(" %8s\n", "tfm/word");
+
+        for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            for (o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+                if ((op == BENCH_MEMSET) && (offsets[o].src != 0)) {
+                    /* memset only has a destination */
+                    continue;
+                }
+
+                for (i = 0; i < NUM_IMPLS; i++) {
+                    if (check_op(&impls[i], op, sizes[s], offsets[o].dst,
+                                 offsets[o].src) != 0) {
+                        printf("%s %s: wrong result, size %zu dst+%zu "
+                               "src+%zu\n", impls[i].name, op_names[op],
+                               sizes[s], offsets[o].dst, offsets[o].src);
+                        failed = 1;
+                    }
+                    mbps[i] = time_op(&impls[i], op, sizes[s], offsets[o].dst,
+                                      offsets[o].src, total_bytes);
+                }
+
+                printf("%6zu %4zu %4zu", sizes[s], offsets[o].dst,
+                       offsets[o].src);
+                for (i = 0; i < NUM_IMPLS; i++) {
+                    printf(" %10.1f", mbps[i]);
+                }
+                printf(" %8.2f\n", (mbps[0] > 0.0) ? mbps[1] / mbps[0] : 0.0);
+            }
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Builds the TF-M runtime library memory routines on the host under their own
+ * names, so they can be measured next to the C library ones.
+ */
+
+#include <string.h>
+
+#define memcpy  tfm_memcpy
+#define memmove tfm_memmove
+#define memset  tfm_memset
+
+#include "crt_memcpy.c"
+#include "crt_memmove.c"
+#include "crt_memset.c"
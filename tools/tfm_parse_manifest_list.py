@@ -1,5 +1,5 @@
 #-------------------------------------------------------------------------------
-# Copyright (c) 2018-2024, Arm Limited. All rights reserved.
+# Copyright (c) 2018-2026, Arm Limited. All rights reserved.
 # Copyright (c) 2022 Cypress Semiconductor Corporation (an Infineon company)
 # or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
 #
@@ -272,7 +272,8 @@ def process_partition_manifests(manifest_lists, configs):
         'CONFIG_TFM_CONNECTION_BASED_SERVICE_API' : '0',
         'CONFIG_TFM_MMIO_REGION_ENABLE'           : '0',
         'CONFIG_TFM_FLIH_API'                     : '0',
-        'CONFIG_TFM_SLIH_API'                     : '0'
+        'CONFIG_TFM_SLIH_API'                     : '0',
+        'CONFIG_TFM_SERVICE_NUM'                  : '0'
     }
     priority_map = {
         'LOWEST'              : '00',
@@ -472,6 +473,8 @@ def process_partition_manifests(manifest_lists, configs):
     if partition_statistics['slih_num'] > 0:
         config_impl['CONFIG_TFM_SLIH_API'] = 1
 
+    config_impl['CONFIG_TFM_SERVICE_NUM'] = process_service_sids(partition_list)
+
     context['partitions'] = partition_list
     context['config_impl'] = config_impl
     context['stateless_services'] = process_stateless_services(partition_list)
@@ -564,6 +567,37 @@ def gen_summary_files(context, gen_file_lists):
         outfile.write(template.render(context))
         outfile.close()
 
+def process_service_sids(partitions):
+    """
+    This function sorts all services by SID and assigns each service its
+    position in the sorted list as 'sid_index'. SPM places the services into a
+    table at these positions and binary searches the table by SID, so the
+    lookup neither walks nor reorders a list at runtime.
+    Returns the total number of services.
+    """
+
+    SERVICE_SID_INDEX_LIMIT = 256
+
+    all_services = []
+    for partition in partitions:
+        all_services.extend(partition['manifest'].get('services', []))
+
+    if len(all_services) > SERVICE_SID_INDEX_LIMIT:
+        raise Exception('Service numbers range exceed {number}.'.format(number=SERVICE_SID_INDEX_LIMIT))
+
+    def sid_value(service):
+        sid = service['sid']
+        return int(sid, 0) if isinstance(sid, str) else int(sid)
+
+    all_services.sort(key=sid_value)
+
+    for i, service in enumerate(all_services):
+        if i > 0 and sid_value(service) == sid_value(all_services[i - 1]):
+            raise Exception('Service ID: {} has duplications!'.format(service['sid']))
+        service['sid_index'] = i
+
+    return len(all_services)
+
 def process_stateless_services(partitions):
     """
     This function collects all stateless services together, and allocates